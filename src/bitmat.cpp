@@ -0,0 +1,172 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "bitmat.h"
+#include <immintrin.h>
+namespace {
+int popcount_scalar(const uint64_t* a, int nw) {
+  int c = 0;
+  for (int i = 0; i < nw; ++i)
+    c += __builtin_popcountll(a[i]);
+  return c;
+}
+int popcount_and_scalar(const uint64_t* a, const uint64_t* b, int nw) {
+  int c = 0;
+  for (int i = 0; i < nw; ++i)
+    c += __builtin_popcountll(a[i] & b[i]);
+  return c;
+}
+int popcount_and3_scalar(const uint64_t* a, const uint64_t* b, const uint64_t* c,
+                         int nw) {
+  int r = 0;
+  for (int i = 0; i < nw; ++i)
+    r += __builtin_popcountll(a[i] & b[i] & c[i]);
+  return r;
+}
+__attribute__((target("avx2"))) inline __m256i popcount_avx2_step(__m256i v) {
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i lo = _mm256_and_si256(v, low_mask);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+  __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                _mm256_shuffle_epi8(lookup, hi));
+  return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+__attribute__((target("avx2"))) inline int hsum_avx2(__m256i acc) {
+  return _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+         _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+}
+__attribute__((target("avx2,popcnt"))) int popcount_avx2(const uint64_t* a, int nw) {
+  __m256i acc = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 4 <= nw; i += 4) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(a + i));
+    acc = _mm256_add_epi64(acc, popcount_avx2_step(v));
+  }
+  int c = hsum_avx2(acc);
+  for (; i < nw; ++i)
+    c += __builtin_popcountll(a[i]);
+  return c;
+}
+__attribute__((target("avx2,popcnt"))) int popcount_and_avx2(const uint64_t* a,
+                                                             const uint64_t* b, int nw) {
+  __m256i acc = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 4 <= nw; i += 4) {
+    __m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                 _mm256_loadu_si256((const __m256i*)(b + i)));
+    acc = _mm256_add_epi64(acc, popcount_avx2_step(v));
+  }
+  int c = hsum_avx2(acc);
+  for (; i < nw; ++i)
+    c += __builtin_popcountll(a[i] & b[i]);
+  return c;
+}
+__attribute__((target("avx2,popcnt"))) int popcount_and3_avx2(const uint64_t* a,
+                                                              const uint64_t* b,
+                                                              const uint64_t* c, int nw) {
+  __m256i acc = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 4 <= nw; i += 4) {
+    __m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                 _mm256_loadu_si256((const __m256i*)(b + i)));
+    v = _mm256_and_si256(v, _mm256_loadu_si256((const __m256i*)(c + i)));
+    acc = _mm256_add_epi64(acc, popcount_avx2_step(v));
+  }
+  int r = hsum_avx2(acc);
+  for (; i < nw; ++i)
+    r += __builtin_popcountll(a[i] & b[i] & c[i]);
+  return r;
+}
+#define AVX512_TARGET __attribute__((target("avx512f,avx512vpopcntdq")))
+AVX512_TARGET inline int hsum_avx512(__m512i acc) {
+  alignas(64) uint64_t lanes[8];
+  _mm512_store_si512(lanes, acc);
+  return accumulate(lanes, lanes + 8, uint64_t(0));
+}
+AVX512_TARGET int popcount_avx512(const uint64_t* a, int nw) {
+  __m512i acc = _mm512_setzero_si512();
+  int i = 0;
+  for (; i + 8 <= nw; i += 8)
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(a + i)));
+  __mmask8 m = (1u << (nw - i)) - 1;
+  acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(m, a + i)));
+  return hsum_avx512(acc);
+}
+AVX512_TARGET int popcount_and_avx512(const uint64_t* a, const uint64_t* b, int nw) {
+  __m512i acc = _mm512_setzero_si512();
+  int i = 0;
+  for (; i + 8 <= nw; i += 8) {
+    __m512i v = _mm512_and_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+  }
+  __mmask8 m = (1u << (nw - i)) - 1;
+  __m512i v = _mm512_and_si512(_mm512_maskz_loadu_epi64(m, a + i),
+                               _mm512_maskz_loadu_epi64(m, b + i));
+  acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+  return hsum_avx512(acc);
+}
+AVX512_TARGET int popcount_and3_avx512(const uint64_t* a, const uint64_t* b,
+                                       const uint64_t* c, int nw) {
+  __m512i acc = _mm512_setzero_si512();
+  int i = 0;
+  for (; i + 8 <= nw; i += 8) {
+    __m512i v = _mm512_and_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+    v = _mm512_and_si512(v, _mm512_loadu_si512(c + i));
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+  }
+  __mmask8 m = (1u << (nw - i)) - 1;
+  __m512i v = _mm512_and_si512(_mm512_maskz_loadu_epi64(m, a + i),
+                               _mm512_maskz_loadu_epi64(m, b + i));
+  v = _mm512_and_si512(v, _mm512_maskz_loadu_epi64(m, c + i));
+  acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+  return hsum_avx512(acc);
+}
+#undef AVX512_TARGET
+struct kernels {
+  int (*popcount)(const uint64_t*, int);
+  int (*popcount_and)(const uint64_t*, const uint64_t*, int);
+  int (*popcount_and3)(const uint64_t*, const uint64_t*, const uint64_t*, int);
+  const char* name;
+};
+kernels select_kernels() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512vpopcntdq"))
+    return {popcount_avx512, popcount_and_avx512, popcount_and3_avx512, "avx512"};
+  if (__builtin_cpu_supports("avx2"))
+    return {popcount_avx2, popcount_and_avx2, popcount_and3_avx2, "avx2"};
+  return {popcount_scalar, popcount_and_scalar, popcount_and3_scalar, "scalar"};
+}
+const kernels impl = select_kernels();
+}
+namespace bits {
+int popcount(const uint64_t* a, int nw) { return impl.popcount(a, nw); }
+int popcount_and(const uint64_t* a, const uint64_t* b, int nw) {
+  return impl.popcount_and(a, b, nw);
+}
+int popcount_and3(const uint64_t* a, const uint64_t* b, const uint64_t* c, int nw) {
+  return impl.popcount_and3(a, b, c, nw);
+}
+const char* kernel_name() { return impl.name; }
+}
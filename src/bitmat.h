@@ -0,0 +1,83 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#pragma once       
+#include "mapped.h"
+#include "util.h"
+namespace bits {
+int popcount(const uint64_t* a, int nw);
+int popcount_and(const uint64_t* a, const uint64_t* b, int nw);
+int popcount_and3(const uint64_t* a, const uint64_t* b, const uint64_t* c, int nw);
+const char* kernel_name();
+inline int words(int n) { return (n + 63) / 64; }
+template <typename F> void for_each(const uint64_t* a, int nw, F f) {
+  for (int i = 0; i < nw; ++i)
+    for (uint64_t x = a[i]; x; x &= x - 1)
+      f(i * 64 + __builtin_ctzll(x));
+}
+}
+struct bit_set {
+  bit_set() = default;
+  bit_set(int n) { assign(n); }
+  void assign(int n) { w.assign(bits::words(n), 0); }
+  void clear() { fill(begin(w), end(w), 0); }
+  bool test(int i) const { return (w[i >> 6] >> (i & 63)) & 1; }
+  void set(int i) { w[i >> 6] |= uint64_t(1) << (i & 63); }
+  void reset(int i) { w[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+  int count() const { return bits::popcount(w.data(), w.size()); }
+  const uint64_t* data() const { return w.data(); }
+  template <typename F> void for_each(F f) const {
+    bits::for_each(w.data(), w.size(), f);
+  }
+  vector<uint64_t> w;
+};
+struct bit_matrix {
+  struct row_ref {
+    const uint64_t* r;
+    int operator[](int j) const { return (r[j >> 6] >> (j & 63)) & 1; }
+  };
+  void assign(int n) {
+    this->n = n, nw = bits::words(n);
+    w.assign(size_t(n) * nw, 0);
+  }
+  void view(int n, const uint64_t* data) {
+    this->n = n, nw = bits::words(n);
+    w.view(data, size_t(n) * nw);
+  }
+  int size() const { return n; }
+  const uint64_t* row(int i) const { return w.data() + size_t(i) * nw; }
+  row_ref operator[](int i) const { return {row(i)}; }
+  bool test(int i, int j) const { return (row(i)[j >> 6] >> (j & 63)) & 1; }
+  void set(int i, int j) { w[size_t(i) * nw + (j >> 6)] |= uint64_t(1) << (j & 63); }
+  void add_edge(int i, int j) { set(i, j), set(j, i); }
+  int degree(int i) const { return bits::popcount(row(i), nw); }
+  int count(int i, const bit_set& s) const {
+    return bits::popcount_and(row(i), s.data(), nw);
+  }
+  int count(int i, const bit_set& s, const bit_set& t) const {
+    return bits::popcount_and3(row(i), s.data(), t.data(), nw);
+  }
+  template <typename F> void for_each(int i, F f) const { bits::for_each(row(i), nw, f); }
+  int n = 0, nw = 0;
+  mapped_vector<uint64_t> w;
+};
@@ -25,7 +25,7 @@
 
 namespace btdsatur {
 
-extern colortype bestcolor;
+extern thread_local colortype bestcolor;
 
 // This makes sure the compiler uses _strtoui64(x, y, z) with Microsoft
 // Compilers, otherwise strtoull(x, y, z) is used
@@ -34,11 +34,11 @@ extern colortype bestcolor;
 #endif
 
 // Global Variables
-unsigned long long numConfChecks;
-unsigned long long maxChecks;
-int verbose;
+thread_local unsigned long long numConfChecks;
+thread_local unsigned long long maxChecks;
+thread_local int verbose;
 ////ofstream timeStream, checksStream;
-clock_t startTime;
+thread_local clock_t startTime;
 
 int colorsearch(int targetnumcolors, timer t, std::vector<int>* res) {
   numConfChecks = 0;
@@ -36,8 +36,8 @@
 namespace btdsatur {
 /* If res != nullptr, populates res with the n colors */
 int colorsearch(int targetnumcolors, timer t, std::vector<int>* res = nullptr);
-extern unsigned long long numConfChecks;
-extern unsigned long long maxChecks;
-extern int verbose;
+extern thread_local unsigned long long numConfChecks;
+extern thread_local unsigned long long maxChecks;
+extern thread_local int verbose;
 } // namespace btdsatur
 #pragma GCC diagnostic pop
@@ -32,11 +32,11 @@
 
     namespace btdsatur {
 
-extern unsigned long long numConfChecks;
-extern unsigned long long maxChecks;
+extern thread_local unsigned long long numConfChecks;
+extern thread_local unsigned long long maxChecks;
 // extern ofstream timeStream, checksStream;
-extern int verbose;
-extern clock_t startTime;
+extern thread_local int verbose;
+extern thread_local clock_t startTime;
 
 /*choose minsat */
 
@@ -68,31 +68,33 @@ int impact(vertextype v, colortype c);
 
 /* global variables */
 
-vertextype nextv[MAXCLR + MAXVERTEX];
-vertextype Prev[MAXCLR + MAXVERTEX];
-vertextype lclindex[MAXCLR + MAXVERTEX];
+thread_local vertextype nextv[MAXCLR + MAXVERTEX];
+thread_local vertextype Prev[MAXCLR + MAXVERTEX];
+thread_local vertextype lclindex[MAXCLR + MAXVERTEX];
 
 /* how many colors are conflicting */
-vertextype satur[MAXVERTEX];
+thread_local vertextype satur[MAXVERTEX];
 /* pointer to position in lists */
-vertextype current[MAXCLR];
+thread_local vertextype current[MAXCLR];
 
-/* total of each adjacent color to vertex */
-short clrset[MAXVERTEX][MAXCLR];
+/* total of each adjacent color to vertex; allocated on first use in each
+   thread */
+thread_local short (*clrset)[MAXCLR] =
+    (short(*)[MAXCLR])calloc(MAXVERTEX, sizeof(short[MAXCLR]));
 
 #ifdef IMPACT
 /* color impacts */
 short impact[MAXVERTEX][MAXCLR];
 #endif
 
-colortype bestcolor, maxsat, minsat;
-vertextype numcolored;
-popmembertype bestmember;
-int Fixed;
-colortype target;
-int maxbranch;
-int minlimit, maxlimit;
-int MinMax;
+thread_local colortype bestcolor, maxsat, minsat;
+thread_local vertextype numcolored;
+thread_local popmembertype bestmember;
+thread_local int Fixed;
+thread_local colortype target;
+thread_local int maxbranch;
+thread_local int minlimit, maxlimit;
+thread_local int MinMax;
 
 /* choose min or max sat? */
 
@@ -117,7 +119,7 @@ void pimpact(void) {
 #endif
 
 /* interrupt control */
-int stopflag = 0;
+thread_local int stopflag = 0;
 void cpulimbk() {
   printf("CPU TIME EXCEEDED -- let me clean up\n");
   stopflag = 1;
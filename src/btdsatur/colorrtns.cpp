@@ -30,8 +30,8 @@
     */
 
     namespace btdsatur {
-extern unsigned long long numConfChecks;
-extern unsigned long long maxChecks;
+extern thread_local unsigned long long numConfChecks;
+extern thread_local unsigned long long maxChecks;
 
 void printinfo(popmembertype* /* member*/) {
   // printf("CLRS =%d\tCLRSUM = %d\n",member->clrdata.numcolors,
@@ -235,7 +235,7 @@ void printperm(popmembertype* m) {
     printf("%d %d\n", m->vc[i].vertex, m->vc[i].color);
 }
 
-int degseq[MAXVERTEX + 1];
+thread_local int degseq[MAXVERTEX + 1];
 
 int decdeg(struct vrtxandclr* a, struct vrtxandclr* b)
 /*
@@ -77,7 +77,7 @@ extern void getacoloring(popmembertype* m, char* name, int* which);
 
 /* PROPERTIES OF GRAPH */
 
-extern int degseq[];
+extern thread_local int degseq[];
 
 extern int decdeg(vrtxandclrtype* a, vrtxandclrtype* b);
 /* comparison routine for decreasing sort by degree */
@@ -33,18 +33,21 @@ using namespace std;
 
 /* Global variables */
 /* GRAPH */
-adjacencytype graph[BTDSATUR_GRAPHSIZE];
-vertextype order;
+// Allocated on first use in each thread, so that threads that never color
+// exactly do not pay for it.
+thread_local adjacencytype* graph =
+    (adjacencytype*)calloc(BTDSATUR_GRAPHSIZE, sizeof(adjacencytype));
+thread_local vertextype order;
 
-extern int verbose;
+extern thread_local int verbose;
 // extern ofstream timeStream, checksStream;
 
 /* partition results for partite graphs  for purity measure */
-int partset[MAXVERTEX];
-int partitionflag;
-int partitionnumber;
+thread_local int partset[MAXVERTEX];
+thread_local int partitionflag;
+thread_local int partitionnumber;
 
-int cheatflag;
+thread_local int cheatflag;
 
 void getcheat(FILE* fp);
 void read_graph_DIMACS_bin(char*);
@@ -50,15 +50,15 @@ set and clear are asymmetric - use setedge(i,j) setedge(j,i) etc.
 typedef int vertextype;
 typedef unsigned char adjacencytype;
 
-extern adjacencytype graph[BTDSATUR_GRAPHSIZE];
-extern vertextype order;
+extern thread_local adjacencytype* graph;
+extern thread_local vertextype order;
 
 /* CHEAT INFORMATION FROM GRAPH */
-extern int partset[MAXVERTEX];
-extern int partitionflag;
-extern int partitionnumber;
+extern thread_local int partset[MAXVERTEX];
+extern thread_local int partitionflag;
+extern thread_local int partitionnumber;
 
-extern int cheatflag;
+extern thread_local int cheatflag;
 
 extern void printgraph();
 extern void getgraph(char a[]);
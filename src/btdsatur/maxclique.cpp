@@ -29,7 +29,7 @@
 #define MAXCUT 100
 #define isnotnbr(x, i) !(((x)[(i) >> SHIFT]) & (1 << ((i)&MASK)))
 
-extern unsigned long long numConfChecks;
+extern thread_local unsigned long long numConfChecks;
 
 typedef struct isinfo {
   vertextype possible, /*vertex not incident to any in IS */
@@ -40,9 +40,9 @@ typedef istype twoDarray[MAXIS][MAXVERTEX];
 typedef twoDarray* twoDarrayp;
 
 /* globals */
-int degree[MAXVERTEX];
+thread_local int degree[MAXVERTEX];
 
-int middeg;
+thread_local int middeg;
 
 int udgcmp(istype* a, istype* b)
 /*
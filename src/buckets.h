@@ -0,0 +1,55 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#pragma once       
+#include "main.h"
+struct degree_buckets {
+  void reset(int max_deg) {
+    if ((int)b.size() <= max_deg) b.resize(max_deg + 1);
+    for (auto& x : b)
+      x.clear();
+    where.resize(::n);
+  }
+  void insert(int v, int d) { where[v] = b[d].size(), b[d].push_back(v); }
+  bool has(int v, int d) const {
+    return where[v] < (int)b[d].size() and b[d][where[v]] == v;
+  }
+  void erase(int v, int d) {
+    int u = b[d].back();
+    b[d][where[v]] = u, where[u] = where[v];
+    b[d].pop_back();
+  }
+  void move(int v, int d, int e) { erase(v, d), insert(v, e); }
+  int sample(int lo, int hi) const {
+    int tot = 0;
+    for (int d = lo; d <= hi; ++d)
+      tot += b[d].size();
+    int r = rand_int(0, tot - 1);
+    for (int d = lo;; ++d) {
+      if (r < (int)b[d].size()) return b[d][r];
+      r -= b[d].size();
+    }
+  }
+  vector<vi> b;
+  vi where;
+};
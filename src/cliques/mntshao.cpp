@@ -31,6 +31,8 @@
 // #include "../main.h"
 #include "../random.h"
 #include "../util.h"
+#include "../bitmat.h"
+#include "../csr.h"
 //#include <stdio.h>
 //#include <stdlib.h>
 //#include <iostream>
@@ -45,7 +47,9 @@
 
 using namespace std;
 
-extern vvi AM;
+extern bit_matrix AM;
+extern csr_graph AL;
+extern bool sparse_graph;
 
 char* File_Name;
 int** Edge; // adjacent matrix
@@ -129,7 +133,7 @@ void Initialize_From_Mem(const vi& s, int k) {
   int max_edg = 0;
   for (uint i = 0; i < s.size(); ++i)
     for (uint j = i + 1; j < s.size(); ++j)
-      if (AM[s[i]][s[j]]) {
+      if (sparse_graph ? AL.has_edge(s[i], s[j]) : AM.test(s[i], s[j])) {
         Edge[i][j] = Edge[j][i] = 0;
         max_edg++;
       }
@@ -22,35 +22,31 @@
 * SOFTWARE.
 */
 #include "color.h"
+#include "arena.h"
 #include "btdsatur/bkdmain.h"
+#include "filters.h"
 #include "hybridea/main.h"
 #include "main.h"
+#include "pool.h"
 void setup_btdsatur(const vi& ss) {
   srand(rand_int(nli::min(), nli::max()));
   btdsatur::order = ss.size();
   btdsatur::maxChecks = 100000000000000LL;
   btdsatur::verbose = 0;
   memset(btdsatur::graph, 0, BTDSATUR_GRAPHSIZE);
-  for (int i = 0; i < (int)ss.size(); ++i)
-    for (int j = i + 1; j < (int)ss.size(); ++j)
-      if (AM[ss[i]][ss[j]]) {
-        btdsatur::setedge(i, j);
-        btdsatur::setedge(j, i);
-      }
+  for_each_induced_edge(ss, [](int i, int j) {
+    btdsatur::setedge(i, j);
+    btdsatur::setedge(j, i);
+  });
 }
 hybridea::Graph& setup_hea(const vi& ss) {
-  static hybridea::Graph g;
-  if (g.n == 0) {
-    g.resize(n);
-  }
+  auto& g = per_thread<hybridea::Graph>();
+  if (g.matrixSize < (int)ss.size())
+    g.resize(min(n, max((int)ss.size(), 2 * g.matrixSize)));
   g.n = ss.size();
-  g.nbEdges = 0;
+  g.nbEdges = ss.size() * (ss.size() - 1) / 2;
   fill(g.matrix, g.matrix + g.n * g.n, 0);
-  for (int i = 0; i < (int)ss.size(); ++i)
-    for (int j = i + 1; j < (int)ss.size(); ++j) {
-      g[i][j] = g[j][i] = AM[ss[i]][ss[j]];
-      ++g.nbEdges;
-    }
+  for_each_induced_edge(ss, [&](int i, int j) { g[i][j] = g[j][i] = 1; });
   return g;
 }
 bool is_k_colorable_exact(int k, const vi& ss, timer t, vi* res) {
@@ -68,7 +64,7 @@ bool is_k_colorable_exact(int k, const vi& ss, timer t, vi* res) {
   } catch (timeout_exception& e) {
     suc = true;
   }
-  stats::color_time += t.elapsed_secs() - tm;
+  stats::add(stats::color_time, t.elapsed_secs() - tm);
   return suc;
 }
 bool is_k_colorable_heuristic(int k, const vi& ss, timer t, vi* res) {
@@ -89,22 +85,68 @@ bool is_k_colorable_heuristic(int k, const vi& ss, timer t, vi* res) {
   } catch (timeout_exception& e) {
     suc = true;
   }
-  stats::color_time += t.elapsed_secs() - tm;
+  stats::add(stats::color_time, t.elapsed_secs() - tm);
   return suc;
 }
+namespace {
+atomic<int> min_size_exact_times_out{nli::max()};
+// Runs the exact algorithm on this thread and the heuristic on a helper
+// thread. The first to answer stops the other: the exact algorithm with a
+// proof or a coloring, the heuristic only with a coloring.
+bb race_colorability(int k, const vi& ss, timer t, vi* res) {
+  auto& duo = per_thread<thread_pool>();
+  if (duo.size() == 1) duo.start(2, rng());
+  ++stats::races;
+  atomic<bool> stop_exact{false}, stop_heu{false};
+  atomic<int> winner{-1};
+  timer te(exact_secs, t), th(heu_secs, t);
+  te.stop_on(stop_exact), th.stop_on(stop_heu);
+  vi res_e, res_h;
+  bool colorable = false;
+  duo.run([&](int w) {
+    int none = -1;
+    if (w == 0) {
+      bool c = is_k_colorable_exact(k, ss, te, res ? &res_e : nullptr);
+      if (te.timed_out() or not winner.compare_exchange_strong(none, 0)) return;
+      colorable = c, stop_heu = true;
+    } else {
+      bool c = is_k_colorable_heuristic(k, ss, th, res ? &res_h : nullptr);
+      if (not c or th.timed_out() or not winner.compare_exchange_strong(none, 1))
+        return;
+      stop_exact = true;
+    }
+  });
+  if (winner == 0) {
+    ++stats::race_exact_wins;
+    if (res) *res = move(res_e);
+    return mp(colorable, true);
+  }
+  if (winner == 1) {
+    ++stats::race_heu_wins;
+    if (res) *res = move(res_h);
+    return mp(true, true);
+  }
+  if (not te.stopped()) min_size_exact_times_out = ss.size();
+  return mp(t.timed_out(), false);
+}
+} // namespace
 bb check_colorability(int k, const vi& ss, timer t, vi* res) {
   TIME_BLOCK("check_colorability");
   ++stats::cals_to_coloring;
-  static int min_size_exact_times_out = nli::max();
-  if (not no_exact_coloring and min_size_exact_times_out > (int)ss.size()) {
+  const bool exact = not no_exact_coloring and
+                     min_size_exact_times_out > (int)ss.size() and
+                     (int)ss.size() < MAXVERTEX;
+  if (portfolio and exact and not no_heuristic_coloring)
+    return race_colorability(k, ss, t, res);
+  if (exact) {
     timer exact_timer(exact_secs, t);
     if (verb >= 3) pr("Running exact algorithm on size {}\n", ss.size());
     bool exactly_colorable = is_k_colorable_exact(k, ss, exact_timer, res);
     if (exact_timer.timed_out()) {
-      min_size_exact_times_out = ss.size();
+      if (not t.stopped()) min_size_exact_times_out = ss.size();
       if (verb >= 2)
         pr("Exact timed out, min_size_exact_times_out: {}\n",
-           min_size_exact_times_out);
+           min_size_exact_times_out.load());
     } else {
       return mp(exactly_colorable, true);
     }
@@ -120,7 +162,41 @@ bb check_colorability(int k, const vi& ss, timer t, vi* res) {
       }
   return mp(t.timed_out(), false);
 }
-bb is_k_vcs(int k, const vi& ss, timer t, vi* res) {
+namespace {
+struct scratch {
+  vi core;
+};
+thread_local vi& core = per_thread<scratch>().core;
+struct verdict {
+  int k, sz;
+  bool colorable;
+};
+unordered_map<uint64_t, verdict> verdicts;
+mutex verdicts_mutex;
+optional<verdict> find_verdict(uint64_t hash, int k, int sz) {
+  ++stats::verdict_lookups;
+  lock_guard<mutex> lock(verdicts_mutex);
+  auto it = verdicts.find(hash);
+  if (it == verdicts.end() or it->second.k != k or it->second.sz != sz) return nullopt;
+  ++stats::verdict_hits;
+  return it->second;
+}
+void store_verdict(uint64_t hash, int k, int sz, bool colorable) {
+  lock_guard<mutex> lock(verdicts_mutex);
+  if (verdicts.size() >= (1u << 20)) verdicts.clear();
+  verdicts[hash] = {k, sz, colorable};
+}
+} // namespace
+bb check_colorability(int k, const vi& ss, uint64_t hash, timer t, vi* res) {
+  if (auto v = find_verdict(hash, k, ss.size())) {
+    if (res) res->clear();
+    return mp(v->colorable, true);
+  }
+  auto r = check_colorability(k, ss, t, res);
+  if (r.second) store_verdict(hash, k, ss.size(), r.first);
+  return r;
+}
+bb check_k_vcs(int k, const vi& ss, timer t, vi* res) {
   auto r = check_colorability(k - 1, ss, t, res);
   if (no_heuristic_coloring and r.second == false) {
     r.first = false;
@@ -129,6 +205,50 @@ bb is_k_vcs(int k, const vi& ss, timer t, vi* res) {
   }
   return r;
 }
+bb is_k_vcs(int k, const vi& ss, timer t, vi* res) {
+  if (res) return check_k_vcs(k, ss, t, res);
+  if (auto r = structural_filter(k, ss, core)) return *r;
+  auto& bl = local_arena().blocks;
+  auto large = [&](const vi& b) { return (int)b.size() >= k; };
+  const int all = blocks(AL, core, bl);
+  const int nb = partition(begin(bl), begin(bl) + all, large) - begin(bl);
+  if (nb == 0) return mp(false, true);
+  if (nb == 1 and bl[0].size() == core.size())
+    return check_k_vcs(k, core, t, nullptr);
+  ++stats::block_splits;
+  sort(begin(bl), begin(bl) + nb,
+       [](const vi& a, const vi& b) { return a.size() < b.size(); });
+  // The workers of the pool take the blocks smallest first, and a sure k-vcs
+  // in any of them stops the others.
+  bool any = false, sure = true;
+  atomic<bool> found{false};
+  atomic<int> next{0};
+  mutex mu;
+  pool().run([&](int) {
+    timer tw = t;
+    tw.stop_on(found);
+    for (int i; not found and (i = next++) < nb;) {
+      auto [is, s] = check_k_vcs(k, bl[i], tw, nullptr);
+      if (is and s) found = true;
+      lock_guard<mutex> lock(mu);
+      any = any or is, sure = sure and s;
+    }
+  });
+  if (found) return mp(true, true);
+  return mp(any, not any and sure);
+}
+bb is_k_vcs(int k, const vi& ss, uint64_t hash, timer t) {
+  if (auto v = find_verdict(hash, k - 1, ss.size())) return mp(not v->colorable, true);
+  auto r = is_k_vcs(k, ss, t);
+  if (r.second) store_verdict(hash, k - 1, ss.size(), not r.first);
+  return r;
+}
+optional<bb> screen_k_vcs(int k, const vi& ss, uint64_t hash) {
+  if (auto v = find_verdict(hash, k - 1, ss.size())) return mp(not v->colorable, true);
+  auto r = structural_filter(k, ss, core);
+  if (r) store_verdict(hash, k - 1, ss.size(), not r->first);
+  return r;
+}
 int color_exactly(const vi& ss, timer t, int lb) {
   setup_btdsatur(ss);
   if (t.secs_left() <= 0) return true;
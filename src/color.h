@@ -26,6 +26,9 @@
 bool is_k_colorable_exact(int k, const vi& ss, timer t, vi* res = nullptr);
 bool is_k_colorable_heuristic(int k, const vi& ss, timer t, vi* res = nullptr);
 bb check_colorability(int k, const vi& ss, timer t, vi* res = nullptr);
+bb check_colorability(int k, const vi& ss, uint64_t hash, timer t, vi* res = nullptr);
 bb is_k_vcs(int k, const vi& ss, timer t, vi* res = nullptr);
+bb is_k_vcs(int k, const vi& ss, uint64_t hash, timer t);
+optional<bb> screen_k_vcs(int k, const vi& ss, uint64_t hash);
 int color_exactly(const vi& ss, timer t, int lb = 1);
 int color_heuristically(const vi& ss, timer t, int lb = 1);
@@ -22,63 +22,114 @@
 * SOFTWARE.
 */
 #include "cons.h"
+#include "arena.h"
 #include "cliques/mntshao.h"
+#include "domain.h"
 #include "subgraph.h"
-void add_partial(subgraph& h, int cur_sz, int target_sz, double alpha) {
+template <typename I>
+void add_partial(basic_subgraph<I>& h, int cur_sz, int target_sz, double alpha) {
   if (cur_sz >= target_sz) return;
+  auto& q = local_arena().cons;
+  const vb& in = in_domain();
   for (int i : h.ss)
-    if (i != -1) h.deg[i] = -1;
-  int j = cur_sz;
-  while (j < target_sz) {
-    auto bst = max_element(begin(h.deg), end(h.deg)) - begin(h.deg);
-    reservoir_sampling rs;
-    int c = bst;
-    for (int i = 0; i < n; ++i)
-      if (h.deg[i] != -1 and
-          ff(double(h.deg[bst] - h.deg[i]) / double(h.deg[bst])) < ff(alpha) and
-          rs.consider())
-        c = i;
-    h.ss[j++] = c;
-    for (int i = 0; i < n; ++i)
-      if (h.deg[i] != -1) {
-        if (i == c)
-          h.deg[i] = -1;
-        else
-          h.deg[i] += AM[i][c];
-      }
+    if (i != I(-1)) h.deg[i] = -1;
+  q.reset(target_sz);
+  int top = 0;
+  for (int i : dom().vs)
+    if (h.deg[i] != I(-1)) q.insert(i, h.deg[i]), top = max(top, int(h.deg[i]));
+  for (int j = cur_sz; j < target_sz; ++j) {
+    while (q.b[top].empty())
+      --top;
+    int lo = top;
+    while (lo > 0 and ff(double(top - lo + 1) / double(top)) < ff(alpha))
+      --lo;
+    int c = q.sample(lo, top);
+    q.erase(c, h.deg[c]);
+    h.ss[j] = c;
+    h.deg[c] = -1;
+    for_each_adjacent(c, [&](int i) {
+      if (h.deg[i] == I(-1) or not in[i]) return;
+      q.move(i, h.deg[i], h.deg[i] + 1);
+      top = max(top, int(++h.deg[i]));
+    });
   }
   h.update_all();
 }
-subgraph cons_add(int sz, int u, double alpha) {
+template <typename I> void cons_add(basic_subgraph<I>& h, int sz, int u, double alpha) {
   TIME_BLOCK("cons_add");
-  subgraph h(sz);
+  h.set_size(sz);
   h.ss[0] = u;
   h.update_all();
   add_partial(h, 1, sz, alpha);
-  return h;
 }
-subgraph cons_drop(int sz, double alpha) {
+template <typename I> void cons_drop(basic_subgraph<I>& h, int sz, double alpha) {
   TIME_BLOCK("cons_drop");
-  subgraph h(ind_n);
+  auto& q = local_arena().cons;
+  struct snapshots {
+    vector<vector<vi>> snaps;
+    vi oldest;
+    double alpha = -1.0;
+    const domain* d = nullptr;
+  };
+  auto& sn = per_thread<snapshots>();
+  auto& snaps = sn.snaps;
+  auto& snaps_alpha = sn.alpha;
+  const domain& d = dom();
+  if (alpha != snaps_alpha or sn.d != &d)
+    snaps.assign(32, {}), sn.oldest.assign(32, 0), snaps_alpha = alpha, sn.d = &d;
+  int lvl = 0;
+  for (int j = 1; (d.n >> j) >= 2 * sz; ++j)
+    if (drop_snapshots > 0 and (int)snaps[j].size() >= drop_snapshots) lvl = j;
+  // Snapshots are only recorded below the level resumed from, so one drop
+  // in drop_snapshots resumes from the next full level up (or the whole
+  // domain), and refreshes the level it skips.
+  if (lvl and rand_int(0, drop_snapshots - 1) == 0)
+    while (--lvl and (int)snaps[lvl].size() < drop_snapshots)
+      ;
+  const vi& from = lvl ? snaps[lvl][rand_int(0, drop_snapshots - 1)] : d.vs;
+  h.ss.assign(begin(from), end(from));
   h.update_all();
+  if (lvl) ++stats::drop_resumes;
+  int top = 0;
+  for (int i : h.ss)
+    top = max(top, int(h.deg[i]));
+  q.reset(top);
+  for (int i : h.ss)
+    q.insert(i, h.deg[i]);
+  int bot = 0, next = lvl + 1;
   while ((int)h.ss.size() > sz) {
-    int bst = -1;
-    for (int i : h.ss)
-      if (bst == -1 or h.deg[i] < h.deg[bst]) bst = i;
-    reservoir_sampling rs;
-    int c = bst;
-    for (int i : h.ss)
-      if (h.deg[i] != nli::infinity() and
-          ff(double(h.deg[i] - h.deg[bst]) / h.deg[i]) < ff(alpha) and
-          rs.consider())
-        c = i;
-    int pos = find(begin(h.ss), end(h.ss), c) - begin(h.ss);
-    swap(h.ss[pos], h.ss.back());
+    while (q.b[bot].empty())
+      ++bot;
+    int hi = bot;
+    while (hi < top and ff(double(hi + 1 - bot) / (hi + 1)) < ff(alpha))
+      ++hi;
+    int c = q.sample(bot, hi);
+    q.erase(c, h.deg[c]);
+    int p = h.pos[c];
+    swap(h.ss[p], h.ss.back());
+    h.pos[h.ss[p]] = p, h.pos[c] = -1;
     h.ss.pop_back();
-    h.deg[c] = nli::infinity();
-    for (int i : h.ss)
-      if (h.deg[i] != nli::infinity() and i != c) h.deg[i] -= AM[i][c];
+    for_each_adjacent(c, [&](int i) {
+      if (not h.contains(i)) return;
+      q.move(i, h.deg[i], h.deg[i] - 1);
+      bot = min(bot, int(--h.deg[i]));
+    });
+    if ((int)h.ss.size() == (d.n >> next)) {
+      if ((int)snaps[next].size() < drop_snapshots) {
+        snaps[next].emplace_back(begin(h.ss), end(h.ss));
+      } else if (drop_snapshots > 0) {
+        int& o = sn.oldest[next];
+        snaps[next][o].assign(begin(h.ss), end(h.ss));
+        o = (o + 1) % drop_snapshots;
+      }
+      ++next;
+    }
   }
   h.update_all();
-  return h;
 }
+template void add_partial(subgraph&, int, int, double);
+template void add_partial(narrow_subgraph&, int, int, double);
+template void cons_add(subgraph&, int, int, double);
+template void cons_add(narrow_subgraph&, int, int, double);
+template void cons_drop(subgraph&, int, double);
+template void cons_drop(narrow_subgraph&, int, double);
@@ -23,7 +23,8 @@
 */
 #pragma once       
 #include "main.h"
-struct subgraph;
-subgraph cons_add(int sz, int u, double alpha);
-void add_partial(subgraph& h, int cur_sz, int target_sz, double alpha);
-subgraph cons_drop(int sz, double alpha);
+template <typename I> struct basic_subgraph;
+template <typename I> void cons_add(basic_subgraph<I>& h, int sz, int u, double alpha);
+template <typename I>
+void add_partial(basic_subgraph<I>& h, int cur_sz, int target_sz, double alpha);
+template <typename I> void cons_drop(basic_subgraph<I>& h, int sz, double alpha);
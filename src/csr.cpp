@@ -0,0 +1,255 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "csr.h"
+void csr_graph::build(int n, const vii& edges) {
+  off.assign(n + 1, 0);
+  for (auto [u, v] : edges)
+    ++off[u + 1], ++off[v + 1];
+  partial_sum(begin(off), end(off), begin(off));
+  vi src(off[n]), pos(n);
+  copy_n(begin(off), n, begin(pos));
+  for (auto [u, v] : edges)
+    src[pos[v]++] = u, src[pos[u]++] = v;
+  adj.resize(off[n]);
+  copy_n(begin(off), n, begin(pos));
+  for (int v = 0; v < n; ++v)
+    for (int i = off[v]; i < off[v + 1]; ++i)
+      adj[pos[src[i]]++] = v;
+  int pos_out = 0;
+  for (int v = 0; v < n; ++v) {
+    auto b = begin(adj) + off[v], e = unique(b, begin(adj) + off[v + 1]);
+    off[v] = pos_out;
+    pos_out = copy(b, e, begin(adj) + pos_out) - begin(adj);
+  }
+  off[n] = pos_out;
+  adj.resize(pos_out);
+}
+bool csr_graph::has_edge(int u, int v) const {
+  if (degree(u) > degree(v)) ::swap(u, v);
+  auto r = (*this)[u];
+  return binary_search(begin(r), end(r), v);
+}
+int csr_graph::count_common(int u, int v) const {
+  return intersect_count((*this)[u], (*this)[v]);
+}
+const int* gallop(const int* b, const int* e, int x) {
+  int step = 1;
+  const int* lo = b;
+  while (lo + step < e and lo[step] < x)
+    lo += step, step *= 2;
+  return lower_bound(lo, min(lo + step + 1, e), x);
+}
+int intersect_count(csr_graph::range a, csr_graph::range b) {
+  if (a.size() > b.size()) ::swap(a, b);
+  int c = 0;
+  const int *i = a.b, *j = b.b;
+  if (a.size() * 16 < b.size()) {
+    for (; i != a.e and j != b.e; ++i) {
+      j = gallop(j, b.e, *i);
+      if (j != b.e and *j == *i) ++c, ++j;
+    }
+    return c;
+  }
+  while (i != a.e and j != b.e) {
+    if (*i < *j)
+      ++i;
+    else if (*j < *i)
+      ++j;
+    else
+      ++c, ++i, ++j;
+  }
+  return c;
+}
+vi core_numbers(const csr_graph& g, vi* order) {
+  const int n = g.size();
+  vi deg(n), bin, vert(n), pos(n);
+  int md = 0;
+  for (int v = 0; v < n; ++v)
+    md = max(md, deg[v] = g.degree(v));
+  bin.assign(md + 1, 0);
+  for (int v = 0; v < n; ++v)
+    ++bin[deg[v]];
+  for (int d = 0, start = 0; d <= md; ++d)
+    start += exchange(bin[d], start);
+  for (int v = 0; v < n; ++v)
+    vert[pos[v] = bin[deg[v]]++] = v;
+  for (int d = md; d > 0; --d)
+    bin[d] = bin[d - 1];
+  bin[0] = 0;
+  for (int i = 0; i < n; ++i) {
+    int v = vert[i];
+    for (int u : g[v])
+      if (deg[u] > deg[v]) {
+        int du = deg[u], pu = pos[u], pw = bin[du], w = vert[pw];
+        if (u != w) pos[u] = pw, pos[w] = pu, vert[pu] = w, vert[pw] = u;
+        ++bin[du], --deg[u];
+      }
+  }
+  if (order) *order = move(vert);
+  return deg;
+}
+vi rcm_order(const csr_graph& g) {
+  const int n = g.size();
+  vi by_deg(n), order, nb;
+  iota(begin(by_deg), end(by_deg), 0);
+  stable_sort(begin(by_deg), end(by_deg),
+              [&](int u, int v) { return g.degree(u) < g.degree(v); });
+  vector<char> seen(n, false);
+  order.reserve(n);
+  for (int s : by_deg) {
+    if (seen[s]) continue;
+    seen[s] = true;
+    order.push_back(s);
+    for (int h = order.size() - 1; h < (int)order.size(); ++h) {
+      nb.clear();
+      for (int u : g[order[h]])
+        if (not seen[u]) seen[u] = true, nb.push_back(u);
+      stable_sort(begin(nb), end(nb),
+                  [&](int u, int v) { return g.degree(u) < g.degree(v); });
+      order.insert(end(order), begin(nb), end(nb));
+    }
+  }
+  reverse(begin(order), end(order));
+  return order;
+}
+vi induced_core(const csr_graph& g, const vi& ss, int d) {
+  vi core;
+  induced_core(g, ss, d, core);
+  return core;
+}
+namespace {
+struct scratch {
+  vi core_pos, core_deg, core_stk;
+  vi bl_pos, bl_disc, bl_low, bl_parent, bl_it, bl_stk, bl_vs;
+};
+} // namespace
+void induced_core(const csr_graph& g, const vi& ss, int d, vi& core) {
+  auto& s = per_thread<scratch>();
+  auto &pos = s.core_pos, &deg = s.core_deg, &stk = s.core_stk;
+  pos.resize(g.size(), -1);
+  const int sz = ss.size();
+  for (int i = 0; i < sz; ++i)
+    pos[ss[i]] = i;
+  deg.assign(sz, 0), stk.clear();
+  for (int i = 0; i < sz; ++i) {
+    for (int u : g[ss[i]])
+      deg[i] += pos[u] >= 0;
+    if (deg[i] < d) stk.push_back(i);
+  }
+  while (not stk.empty()) {
+    int i = stk.back();
+    stk.pop_back();
+    pos[ss[i]] = -1;
+    for (int u : g[ss[i]])
+      if (pos[u] >= 0 and deg[pos[u]]-- == d) stk.push_back(pos[u]);
+  }
+  core.clear();
+  for (int v : ss)
+    if (pos[v] >= 0) {
+      core.push_back(v);
+      pos[v] = -1;
+    }
+}
+csr_graph permuted(const csr_graph& g, const vi& order) {
+  const int n = g.size();
+  vi pos(n);
+  for (int i = 0; i < n; ++i)
+    pos[order[i]] = i;
+  csr_graph h;
+  h.off.assign(n + 1, 0);
+  h.adj.resize(g.num_arcs());
+  for (int i = 0; i < n; ++i) {
+    auto r = g[order[i]];
+    h.off[i + 1] = h.off[i] + r.size();
+    int* row = h.adj.data() + h.off[i];
+    transform(begin(r), end(r), row, [&](int u) { return pos[u]; });
+    sort(row, row + r.size());
+  }
+  return h;
+}
+csr_graph induced_subgraph(const csr_graph& g, const vi& vs) {
+  vi pos(g.size(), -1);
+  for (int i = 0; i < (int)vs.size(); ++i)
+    pos[vs[i]] = i;
+  csr_graph h;
+  h.off.assign(vs.size() + 1, 0);
+  for (int i = 0; i < (int)vs.size(); ++i)
+    for (int u : g[vs[i]])
+      h.off[i + 1] += pos[u] >= 0;
+  partial_sum(begin(h.off), end(h.off), begin(h.off));
+  h.adj.resize(h.off[vs.size()]);
+  for (int i = 0, j = 0; i < (int)vs.size(); ++i)
+    for (int u : g[vs[i]])
+      if (pos[u] >= 0) h.adj[j++] = pos[u];
+  return h;
+}
+int blocks(const csr_graph& g, const vi& ss, vector<vi>& res) {
+  auto& s = per_thread<scratch>();
+  auto &pos = s.bl_pos, &disc = s.bl_disc, &low = s.bl_low, &parent = s.bl_parent;
+  auto &it = s.bl_it, &stk = s.bl_stk, &vs = s.bl_vs;
+  pos.resize(g.size(), -1);
+  const int sz = ss.size();
+  for (int i = 0; i < sz; ++i)
+    pos[ss[i]] = i;
+  disc.assign(sz, -1), low.resize(sz), parent.assign(sz, -1), it.assign(sz, 0);
+  int cnt = 0;
+  for (int r = 0, t = 0; r < sz; ++r) {
+    if (disc[r] != -1) continue;
+    disc[r] = low[r] = t++;
+    stk.assign(1, r), vs.assign(1, r);
+    while (not stk.empty()) {
+      int v = stk.back();
+      auto nb = g[ss[v]];
+      if (it[v] < nb.size()) {
+        int u = pos[nb[it[v]++]];
+        if (u < 0) continue;
+        if (disc[u] == -1) {
+          parent[u] = v, disc[u] = low[u] = t++;
+          stk.push_back(u), vs.push_back(u);
+        } else if (u != parent[v]) {
+          low[v] = min(low[v], disc[u]);
+        }
+        continue;
+      }
+      stk.pop_back();
+      if (stk.empty()) break;
+      int p = stk.back();
+      low[p] = min(low[p], low[v]);
+      if (low[v] >= disc[p]) {
+        if (cnt == (int)res.size()) res.emplace_back();
+        vi& b = res[cnt++];
+        b.assign(1, ss[p]);
+        int w;
+        do {
+          w = vs.back();
+          vs.pop_back();
+          b.push_back(ss[w]);
+        } while (w != v);
+      }
+    }
+  }
+  for (int v : ss)
+    pos[v] = -1;
+  return cnt;
+}
@@ -0,0 +1,59 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#pragma once       
+#include "mapped.h"
+#include "util.h"
+struct csr_graph {
+  struct range {
+    const int *b, *e;
+    const int* begin() const { return b; }
+    const int* end() const { return e; }
+    int size() const { return e - b; }
+    bool empty() const { return b == e; }
+    int operator[](int i) const { return b[i]; }
+  };
+  csr_graph() { off.assign(1, 0); }
+  void build(int n, const vii& edges);
+  void view(int n, const int* off, const int* adj) {
+    this->off.view(off, n + 1), this->adj.view(adj, off[n]);
+  }
+  int size() const { return (int)off.size() - 1; }
+  int num_arcs() const { return adj.size(); }
+  range operator[](int v) const {
+    return {adj.data() + off[v], adj.data() + off[v + 1]};
+  }
+  int degree(int v) const { return off[v + 1] - off[v]; }
+  bool has_edge(int u, int v) const;
+  int count_common(int u, int v) const;
+  mapped_vector<int> off, adj;
+};
+const int* gallop(const int* b, const int* e, int x);
+int intersect_count(csr_graph::range a, csr_graph::range b);
+vi core_numbers(const csr_graph& g, vi* order = nullptr);
+vi rcm_order(const csr_graph& g);
+vi induced_core(const csr_graph& g, const vi& ss, int d);
+void induced_core(const csr_graph& g, const vi& ss, int d, vi& core);
+int blocks(const csr_graph& g, const vi& ss, vector<vi>& res);
+csr_graph induced_subgraph(const csr_graph& g, const vi& vs);
+csr_graph permuted(const csr_graph& g, const vi& order);
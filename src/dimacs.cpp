@@ -0,0 +1,132 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "dimacs.h"
+#include <charconv>
+namespace {
+struct line_scanner {
+  const char *p, *e;
+  void skip_blanks() {
+    while (p != e and (*p == ' ' or *p == '\t' or *p == '\r')) ++p;
+  }
+  bool read_int(int& x) {
+    skip_blanks();
+    auto r = from_chars(p, e, x);
+    if (r.ec != errc()) return false;
+    p = r.ptr;
+    return true;
+  }
+  string_view read_word() {
+    skip_blanks();
+    const char* b = p;
+    while (p != e and not isspace((unsigned char)*p)) ++p;
+    return string_view(b, p - b);
+  }
+};
+bool iequals(string_view a, string_view b) {
+  auto eq = [](char x, char y) { return tolower(x) == y; };
+  return a.size() == b.size() and equal(begin(a), end(a), begin(b), eq);
+}
+int last_int(string_view line) {
+  while (line.size() and isspace((unsigned char)line.back())) line.remove_suffix(1);
+  auto pos = line.find_last_of(" \t");
+  string_view tok = pos == string_view::npos ? line : line.substr(pos + 1);
+  int x = 0;
+  from_chars(tok.data(), tok.data() + tok.size(), x);
+  return x;
+}
+}
+void parse_dimacs(const string& filename, graph_cache& gc, graph_mode mode) {
+  mapped_file f;
+  if (not f.open(filename)) {
+    print("Could not open input file.\n");
+    exit(EXIT_FAILURE);
+  }
+  const char *p = f.data(), *eof = p + f.size();
+  int n = 0, m = 0;
+  vii edges;
+  string_view line;
+  bool invalid = false;
+  while (not invalid and p != eof) {
+    const char* nl = (const char*)memchr(p, '\n', eof - p);
+    if (not nl) nl = eof;
+    line = string_view(p, nl - p);
+    p = nl == eof ? eof : nl + 1;
+    line_scanner ls{line.data(), line.data() + line.size()};
+    ls.skip_blanks();
+    if (ls.p == ls.e) continue;
+    line = string_view(ls.p, ls.e - ls.p);
+    if (line[0] == 'c') {
+      if (line.substr(0, 4) == "c k ")
+        gc.k_its = last_int(line);
+      else if (line.substr(0, 15) == "c Random graph,")
+        gc.k_irace = last_int(line);
+    } else if (line[0] == 'p') {
+      ls.read_word();
+      auto fmt = ls.read_word();
+      if ((not iequals(fmt, "edge") and not iequals(fmt, "col")) or not ls.read_int(n) or
+          not ls.read_int(m) or n < 0 or m < 0)
+        invalid = true;
+      else
+        edges.reserve(m);
+    } else if (line[0] == 'e') {
+      ls.read_word();
+      int v1, v2;
+      if (not ls.read_int(v1) or not ls.read_int(v2) or not inrange(v1, 1, n) or
+          not inrange(v2, 1, n)) {
+        invalid = true;
+        break;
+      }
+      edges.emplace_back(v1 - 1, v2 - 1);
+    } else
+      invalid = true;
+  }
+  if (invalid) {
+    print("Error: instance {} does not seem to be in DIMACS col format.\n", filename);
+    print("Line: {}\n", line);
+    exit(EXIT_FAILURE);
+  }
+  auto& g = gc.raw;
+  g.AL.build(n, edges);
+  vii().swap(edges);
+  g.n = n, g.m = 0, g.k = 0;
+  for (int u = 0; u < n; ++u)
+    for (int v : g.AL[u])
+      g.m += u <= v;
+  g.fit(is_sparse(mode, n, g.m));
+  g.vmap.resize(n);
+  iota(begin(g.vmap), end(g.vmap), 0);
+}
+bool load_graph(const string& filename, const string& cache_filename, graph_cache& gc,
+                graph_mode mode, bool save) {
+  bool hit = not cache_filename.empty() and gc.open(cache_filename, filename);
+  if (not hit) {
+    parse_dimacs(filename, gc, mode);
+    if (save and not cache_filename.empty() and gc.save(cache_filename, filename))
+      gc.open(cache_filename, filename);
+  }
+  const bool sparse = is_sparse(mode, gc.raw.n, gc.raw.m);
+  gc.raw.fit(sparse);
+  if (gc.core.n > 0) gc.core.fit(sparse);
+  return hit;
+}
@@ -0,0 +1,61 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "domain.h"
+namespace {
+domain make_domain(int id, vi vs) {
+  domain d;
+  d.id = id, d.n = vs.size(), d.vs = move(vs);
+  if (d.whole()) {
+    d.m = m, d.ind_deg = ind_deg, d.ind_deg_cum = ind_deg_cum;
+    return d;
+  }
+  bit_set in(n);
+  for (int v : d.vs)
+    in.set(v);
+  d.ind_deg = d.vs;
+  sort_by_degree(d.ind_deg);
+  d.ind_deg_cum.resize(d.n);
+  for (int i = 0, cum = 0; i < d.n; ++i)
+    d.ind_deg_cum[i] = cum += count_adjacent(d.ind_deg[i], in);
+  d.m = d.n ? d.ind_deg_cum.back() / 2 : 0;
+  return d;
+}
+}
+void build_domains(int k) {
+  domains.clear();
+  domains.push_back(make_domain(0, ind_n));
+  vector<vi> bl;
+  const int nb = blocks(AL, ind_n, bl);
+  int large = 0;
+  for (int i = 0; i < nb; ++i)
+    if ((int)bl[i].size() >= k) swap(bl[large++], bl[i]);
+  if (large > 1) {
+    sort(begin(bl), begin(bl) + large,
+         [](const vi& a, const vi& b) { return a.size() > b.size(); });
+    for (int i = 0; i < large; ++i)
+      domains.push_back(make_domain(i + 1, move(bl[i])));
+    stats::search_blocks = large;
+  }
+  main_domain = &domains[0];
+}
@@ -0,0 +1,60 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#pragma once       
+#include "main.h"
+// Vertex set in which the search builds its candidates. Since a k-VCS is
+// 2-connected, it lies inside a single block, and with several blocks of at
+// least k vertices each is searched on its own. domains[0] is the whole graph.
+struct domain {
+  int id = 0, n = 0, m = 0;
+  vi vs;
+  vi ind_deg, ind_deg_cum;
+  bool whole() const { return n == ::n; }
+};
+inline vector<domain> domains;
+// The domain of the search. Pool workers use main_domain, unless they set
+// local_domain to search a block of their own.
+inline const domain* main_domain = nullptr;
+inline thread_local const domain* local_domain = nullptr;
+inline const domain& dom() { return local_domain ? *local_domain : *main_domain; }
+struct domain_mask {
+  const domain* d = nullptr;
+  vb in;
+};
+// Membership flags of dom(), kept per thread and updated when it changes.
+inline const vb& in_domain() {
+  static thread_local domain_mask& mk = per_thread<domain_mask>();
+  const domain& d = dom();
+  if (mk.d != &d) {
+    if (mk.d)
+      for (int v : mk.d->vs)
+        mk.in[v] = false;
+    mk.in.resize(::n, false);
+    for (int v : d.vs)
+      mk.in[v] = true;
+    mk.d = &d;
+  }
+  return mk.in;
+}
+void build_domains(int k);
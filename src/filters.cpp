@@ -0,0 +1,165 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "filters.h"
+#include "arena.h"
+#include "main.h"
+#include "stats.h"
+namespace {
+struct scratch {
+  vector<vi> adj, lv;
+  vector<uint64_t> used;
+  vi sat, deg, d, ord, at;
+  vector<int64_t> pre;
+};
+thread_local scratch& sc = per_thread<scratch>();
+thread_local vector<vi>& adj = sc.adj;
+thread_local vector<uint64_t>& used = sc.used;
+thread_local vi &sat = sc.sat, &deg = sc.deg, &d = sc.d;
+thread_local vector<int64_t>& pre = sc.pre;
+void build_adj(const vi& core) {
+  const int c = core.size();
+  if ((int)adj.size() < c) adj.resize(c);
+  for (int i = 0; i < c; ++i)
+    adj[i].clear();
+  for_each_induced_edge(core, [](int i, int j) {
+    adj[i].push_back(j), adj[j].push_back(i);
+  });
+}
+bool dsatur(int k, int c) {
+  auto& q = local_arena().in;
+  q.reset(k - 1);
+  used.assign(c, 0), sat.assign(c, 0);
+  for (int i = 0; i < c; ++i)
+    q.insert(i, 0);
+  for (int top = 0, left = c; left > 0; --left) {
+    while (q.b[top].empty())
+      --top;
+    int v = q.b[top].back();
+    q.erase(v, top), sat[v] = -1;
+    int col = __builtin_ctzll(~used[v]);
+    for (int u : adj[v])
+      if (sat[u] >= 0 and not (used[u] >> col & 1)) {
+        used[u] |= uint64_t(1) << col;
+        if (++sat[u] == k - 1) return false;
+        q.move(u, sat[u] - 1, sat[u]);
+        top = max(top, sat[u]);
+      }
+  }
+  return true;
+}
+// Degeneracy order of the core, and the position of each vertex in it, so
+// that a clique is only ever extended by later neighbors.
+thread_local vi &ord = sc.ord, &at = sc.at;
+thread_local vector<vi>& lv = sc.lv;
+bool has_clique(const vi& core, int need, int64_t& budget) {
+  if (need == 0) return true;
+  const vi& cand = lv[need];
+  if ((int)cand.size() < need or --budget < 0) return false;
+  for (int i = 0; i + need <= (int)cand.size(); ++i) {
+    auto& next = lv[need - 1];
+    next.clear();
+    for (int j = i + 1; j < (int)cand.size(); ++j)
+      if (adjacent(core[cand[i]], core[cand[j]])) next.push_back(cand[j]);
+    if (has_clique(core, need - 1, budget)) return true;
+    if (budget < 0) return false;
+  }
+  return false;
+}
+// Returns 1 if the core has a k-clique, 0 if it has none, and -1 if the
+// search ran out of budget.
+int find_clique(int k, const vi& core, int64_t budget) {
+  const int c = core.size();
+  auto& q = local_arena().in;
+  deg.assign(c, 0), at.assign(c, -1), ord.clear();
+  int top = 0;
+  for (int i = 0; i < c; ++i)
+    top = max(top, deg[i] = adj[i].size());
+  q.reset(top);
+  for (int i = 0; i < c; ++i)
+    q.insert(i, deg[i]);
+  for (int bot = 0; (int)ord.size() < c;) {
+    bot = max(bot - 1, 0);
+    while (q.b[bot].empty())
+      ++bot;
+    int v = q.b[bot].back();
+    q.erase(v, bot), at[v] = ord.size(), ord.push_back(v);
+    for (int u : adj[v])
+      if (at[u] < 0) q.move(u, deg[u], deg[u] - 1), --deg[u];
+  }
+  if ((int)lv.size() < k) lv.resize(k);
+  auto& cand = lv[k - 1];
+  for (int v : ord) {
+    cand.clear();
+    for (int u : adj[v])
+      if (at[u] > at[v]) cand.push_back(u);
+    if ((int)cand.size() < k - 1) continue;
+    sort(begin(cand), end(cand), [](int a, int b) { return at[a] < at[b]; });
+    if (has_clique(core, k - 1, budget)) return 1;
+    if (budget < 0) return -1;
+  }
+  return 0;
+}
+// Whether some n' > k vertices of the core could span as many edges as the
+// Kostochka-Yancey bound requires of a k-critical graph on n' vertices,
+// 2m >= ((k+1)(k-2)n' - k(k-3)) / (k-1).
+bool ky_room(int k, int c) {
+  d.resize(c), pre.assign(c + 1, 0);
+  for (int i = 0; i < c; ++i)
+    d[i] = adj[i].size();
+  sort(begin(d), begin(d) + c, greater<int>());
+  for (int i = 0; i < c; ++i)
+    pre[i + 1] = pre[i] + d[i];
+  for (int np = k + 1, t = c; np <= c; ++np) {
+    while (t > 0 and d[t - 1] < np - 1)
+      --t;
+    int64_t cap = min(t, np);
+    int64_t s = (np - 1) * cap + pre[np] - pre[cap];
+    if (s * (k - 1) >= int64_t(k + 1) * (k - 2) * np - k * (k - 3)) return true;
+  }
+  return false;
+}
+} // namespace
+optional<bb> structural_filter(int k, const vi& ss, vi& core) {
+  induced_core(AL, ss, k - 1, core);
+  if (k < 3) return nullopt;
+  if ((int)core.size() < k) {
+    ++stats::filter_core;
+    return mp(false, true);
+  }
+  const int c = core.size();
+  build_adj(core);
+  if (k - 1 <= 64 and dsatur(k, c)) {
+    ++stats::filter_dsatur;
+    return mp(false, true);
+  }
+  if (not ky_room(k, c)) {
+    int r = find_clique(k, core, 100000);
+    if (r >= 0) ++(r ? stats::filter_clique : stats::filter_ky);
+    if (r >= 0) return mp(r == 1, true);
+  } else if (find_clique(k, core, 1000) == 1) {
+    ++stats::filter_clique;
+    return mp(true, true);
+  }
+  return nullopt;
+}
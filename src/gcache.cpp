@@ -0,0 +1,158 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "gcache.h"
+namespace {
+struct file_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_blocks;
+  uint64_t src_size;
+  int64_t src_mtime;
+  int32_t k_its, k_irace;
+  uint64_t block_pos[2];
+};
+enum { sec_off, sec_adj, sec_am, sec_vmap, sec_ind_deg, sec_ind_deg_cum, num_secs };
+struct block_header {
+  int32_t n, m, k, pad;
+  uint64_t pos[num_secs];
+  uint64_t len[num_secs];
+};
+const char magic[8] = {'C', 'R', 'I', 'T', 'G', 'R', 'P', 'H'};
+bool source_id(const string& source, uint64_t& size, int64_t& mtime) {
+  struct stat st;
+  if (stat(source.c_str(), &st) != 0) return false;
+  size = st.st_size;
+  mtime = int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+  return true;
+}
+uint64_t align(uint64_t pos) { return (pos + 63) / 64 * 64; }
+void write_at(ofstream& f, uint64_t pos, const void* data, size_t len) {
+  f.seekp(pos);
+  f.write((const char*)data, len);
+}
+uint64_t write_block(ofstream& f, uint64_t pos, const graph_block& g) {
+  block_header h{};
+  h.n = g.n, h.m = g.m, h.k = g.k;
+  const void* data[num_secs] = {g.AL.off.data(), g.AL.adj.data(), g.AM.w.data(),
+                                g.vmap.data(),   g.ind_deg.data(), g.ind_deg_cum.data()};
+  h.len[sec_off] = g.AL.off.size() * sizeof(int);
+  h.len[sec_adj] = g.AL.adj.size() * sizeof(int);
+  h.len[sec_am] = g.AM.w.size() * sizeof(uint64_t);
+  h.len[sec_vmap] = g.vmap.size() * sizeof(int);
+  h.len[sec_ind_deg] = g.ind_deg.size() * sizeof(int);
+  h.len[sec_ind_deg_cum] = g.ind_deg_cum.size() * sizeof(int);
+  uint64_t cur = align(pos + sizeof(h));
+  for (int s = 0; s < num_secs; ++s) {
+    h.pos[s] = cur;
+    write_at(f, cur, data[s], h.len[s]);
+    cur = align(cur + h.len[s]);
+  }
+  write_at(f, pos, &h, sizeof(h));
+  return cur;
+}
+bool read_block(const mapped_file& mf, uint64_t pos, graph_block& g) {
+  if (pos + sizeof(block_header) > mf.size()) return false;
+  block_header h;
+  memcpy(&h, mf.data() + pos, sizeof(h));
+  for (int s = 0; s < num_secs; ++s)
+    if (h.pos[s] % 64 != 0 or (h.len[s] and h.pos[s] + h.len[s] > mf.size()))
+      return false;
+  const size_t nw = bits::words(h.n);
+  if (h.n <= 0 or h.len[sec_off] != (h.n + 1) * sizeof(int) or
+      (h.len[sec_am] and h.len[sec_am] != h.n * nw * sizeof(uint64_t)) or
+      h.len[sec_vmap] != h.n * sizeof(int))
+    return false;
+  auto sec = [&](int s) { return mf.data() + h.pos[s]; };
+  const int* off = (const int*)sec(sec_off);
+  if (h.len[sec_adj] != off[h.n] * sizeof(int)) return false;
+  g.n = h.n, g.m = h.m, g.k = h.k;
+  g.AL.view(h.n, off, (const int*)sec(sec_adj));
+  if (h.len[sec_am]) g.AM.view(h.n, (const uint64_t*)sec(sec_am));
+  auto copy = [&](int s, vi& v) {
+    const int* p = (const int*)sec(s);
+    v.assign(p, p + h.len[s] / sizeof(int));
+  };
+  copy(sec_vmap, g.vmap);
+  copy(sec_ind_deg, g.ind_deg);
+  copy(sec_ind_deg_cum, g.ind_deg_cum);
+  return true;
+}
+}
+bool is_sparse(graph_mode mode, int n, int m) {
+  if (mode != graph_mode::automatic) return mode == graph_mode::sparse;
+  return n > 4096 and 2 * int64_t(m) < int64_t(n) * (n / 64);
+}
+void graph_block::fit(bool sparse) {
+  if (sparse) {
+    AM = bit_matrix();
+  } else if (AM.size() != n) {
+    AM.assign(n);
+    for (int u = 0; u < n; ++u)
+      for (int v : AL[u])
+        AM.set(u, v);
+  }
+}
+bool graph_cache::open(const string& filename, const string& source) {
+  mapped_file mf;
+  if (not mf.open(filename)) return false;
+  file_header h;
+  uint64_t src_size;
+  int64_t src_mtime;
+  graph_block r, c;
+  bool ok = mf.size() >= sizeof(h);
+  if (ok) memcpy(&h, mf.data(), sizeof(h));
+  ok = ok and memcmp(h.magic, magic, sizeof(magic)) == 0 and h.version == version and
+       inrange(h.num_blocks, 1u, 2u) and source_id(source, src_size, src_mtime) and
+       h.src_size == src_size and h.src_mtime == src_mtime;
+  ok = ok and read_block(mf, h.block_pos[0], r);
+  ok = ok and (h.num_blocks == 1 or read_block(mf, h.block_pos[1], c));
+  if (not ok) return false;
+  swap(file.base, mf.base), swap(file.len, mf.len);
+  raw = move(r), core = move(c);
+  k_its = h.k_its, k_irace = h.k_irace;
+  return true;
+}
+bool graph_cache::save(const string& filename, const string& source) const {
+  file_header h{};
+  memcpy(h.magic, magic, sizeof(magic));
+  h.version = version;
+  h.num_blocks = core.n > 0 ? 2 : 1;
+  h.k_its = k_its, h.k_irace = k_irace;
+  if (not source_id(source, h.src_size, h.src_mtime)) return false;
+  string tmp = format("{}.{}.tmp", filename, getpid());
+  {
+    ofstream f(tmp, ios::binary | ios::trunc);
+    if (not f) return false;
+    h.block_pos[0] = align(sizeof(h));
+    uint64_t end = write_block(f, h.block_pos[0], raw);
+    if (core.n > 0) h.block_pos[1] = end, end = write_block(f, end, core);
+    write_at(f, 0, &h, sizeof(h));
+    if (not f.good()) {
+      f.close();
+      remove(tmp.c_str());
+      return false;
+    }
+  }
+  return rename(tmp.c_str(), filename.c_str()) == 0;
+}
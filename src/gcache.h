@@ -0,0 +1,49 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#pragma once       
+#include "bitmat.h"
+#include "csr.h"
+#include "mapped.h"
+#include "util.h"
+enum class graph_mode { automatic, dense, sparse };
+bool is_sparse(graph_mode mode, int n, int m);
+struct graph_block {
+  void fit(bool sparse);
+  int n = 0, m = 0, k = 0;
+  bit_matrix AM;
+  csr_graph AL;
+  vi vmap, ind_deg, ind_deg_cum;
+};
+struct graph_cache {
+  // 2: the core block also drops the blocks of the (k-1)-core with fewer
+  // than k vertices.
+  static constexpr uint32_t version = 2;
+  bool open(const string& filename, const string& source);
+  bool save(const string& filename, const string& source) const;
+  bool is_mapped() const { return file.data() != nullptr; }
+  bool has_core(int k) const { return core.n > 0 and core.k == k; }
+  mapped_file file;
+  graph_block raw, core;
+  int k_its = 0, k_irace = 0;
+};
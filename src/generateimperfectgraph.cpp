@@ -21,13 +21,17 @@
 * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 * SOFTWARE.
 */
+#include "bitmat.h"
 #include "btdsatur/bkdmain.h"
 #include "cliques/mntshao.h"
+#include "gcache.h"
 #include "hybridea/main.h"
 #include "util.h"
 int n, k, seed, cl;
 double d;
-vvi AM;
+bit_matrix AM;
+csr_graph AL;
+bool sparse_graph = false;
 double clique_tl = 5;
 double exa_tl = 5;
 double heu_tl = 5;
@@ -41,7 +45,7 @@ int cols_heu() {
   fill(g.matrix, g.matrix + g.n * g.n, 0);
   for (int i = 0; i < n; ++i)
     for (int j = i + 1; j < n; ++j) {
-      g[i][j] = g[j][i] = AM[i][j];
+      g[i][j] = g[j][i] = AM.test(i, j);
       ++g.nbEdges;
     }
   int rnd_seed = rand_int(nli::min(), nli::max());
@@ -57,7 +61,7 @@ pair<bool, int> cols_exa() {
   memset(btdsatur::graph, 0, BTDSATUR_GRAPHSIZE);
   for (int i = 0; i < n; ++i)
     for (int j = i + 1; j < n; ++j)
-      if (AM[i][j]) {
+      if (AM.test(i, j)) {
         btdsatur::setedge(i, j);
         btdsatur::setedge(j, i);
       }
@@ -78,10 +82,26 @@ int clique() {
   }
   return hao_mnts_max_clique(indn, n, timer(clique_tl)).size();
 }
+void write_cache(const string& cache_file, const string& out_file) {
+  graph_cache gc;
+  vii edges;
+  for (int i = 0; i < n; ++i)
+    AM.for_each(i, [&](int j) {
+      if (i < j) edges.emplace_back(i, j);
+    });
+  gc.raw.n = n, gc.raw.m = edges.size();
+  gc.raw.AM = AM;
+  gc.raw.AL.build(n, edges);
+  gc.raw.vmap.resize(n);
+  iota(begin(gc.raw.vmap), end(gc.raw.vmap), 0);
+  gc.k_irace = k;
+  if (not gc.save(cache_file, out_file)) pr("Could not write {}.\n", cache_file);
+}
 int main(int argc, char** argv) {
-  if (argc != 5) {
-    pr("Usage: ./generateimperfectgraph num_vertices density seed out_file. "
-       "Incorrect "
+  if (argc != 5 and argc != 6) {
+    pr("Usage: ./generateimperfectgraph num_vertices density seed out_file "
+       "[cache_file]. If cache_file is given, a binary graph cache of the "
+       "output is also written (see option --gcache). Incorrect "
        "parameter types will not be checked against.\n");
     exit(EXIT_SUCCESS);
   }
@@ -90,7 +110,7 @@ int main(int argc, char** argv) {
   seed = atoi(argv[3]);
   string out_file = argv[4];
   rng.seed(seed);
-  AM.assign(n, vi(n, 0));
+  AM.assign(n);
   timer t;
   int iter = 0;
   int num_edges = int((n * (n - 1) * d) / 2.0);
@@ -104,8 +124,7 @@ int main(int argc, char** argv) {
     while ((int)chosen.size() != num_edges)
       chosen.insert(rand_int(0, (int)edges.size() - 1));
     for (int i : chosen) {
-      AM[edges[i].first][edges[i].second] =
-          AM[edges[i].second][edges[i].first] = 1;
+      AM.add_edge(edges[i].first, edges[i].second);
     }
     cl = clique();
     auto [exa_ok, exa_cols] = cols_exa();
@@ -122,9 +141,10 @@ int main(int argc, char** argv) {
       of << format("p edge {} {}\n", n, num_edges);
       for (int i = 0; i < n; ++i)
         for (int j = i + 1; j < n; ++j)
-          if (AM[i][j]) of << format("e {} {}\n", i + 1, j + 1);
+          if (AM.test(i, j)) of << format("e {} {}\n", i + 1, j + 1);
       pr("{} {}\n", out_file, k);
       of.close();
+      if (argc == 6) write_cache(argv[5], out_file);
       return 0;
     }
   }
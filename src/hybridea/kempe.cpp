@@ -18,7 +18,7 @@
 #include <limits.h>
 
 namespace hybridea {
-extern unsigned long long numConfChecks;
+extern thread_local unsigned long long numConfChecks;
 
 // CONSTANTS USED FOR IDENTIFYING KEMP CHAINS
 const int WHITE = 0;
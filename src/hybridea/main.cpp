@@ -54,7 +54,7 @@ using namespace std;
 // void replace(vector<vector<int>>& population, vector<int>& parents,
 //              vector<int>& osp, vector<int>& popCosts, Graph& g, int oCost);
 
-unsigned long long numConfChecks;
+thread_local unsigned long long numConfChecks;
 
 //*********************************************************************
 inline bool solIsOptimal(const vector<int>& sol, Graph& g, int k) {
@@ -122,11 +122,16 @@ int hea(Graph& g, timer tm, unsigned long long maxChecks, int targetCols,
   }
 
   // Make the adjacency list structure
-  static int** neighbors = nullptr;
-  if (neighbors == nullptr) {
-    neighbors = new int*[g.matrixSize];
-    for (int i = 0; i < g.matrixSize; ++i)
-      neighbors[i] = new int[g.matrixSize + 1];
+  static thread_local int** neighbors = nullptr;
+  static thread_local int neighborsSize = 0;
+  if (neighborsSize < g.matrixSize) {
+    for (int i = 0; i < neighborsSize; ++i)
+      delete[] neighbors[i];
+    delete[] neighbors;
+    neighborsSize = g.matrixSize;
+    neighbors = new int*[neighborsSize];
+    for (int i = 0; i < neighborsSize; ++i)
+      neighbors[i] = new int[neighborsSize + 1];
   }
   makeAdjList(neighbors, g);
 
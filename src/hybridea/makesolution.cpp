@@ -19,7 +19,7 @@
 namespace hybridea {
 constexpr int ASSIGNED = INT_MIN;
 
-extern unsigned long long numConfChecks;
+extern thread_local unsigned long long numConfChecks;
 
 //-------------------------------------------------------------------------------------
 inline void swap(int& a, int& b) {
@@ -17,7 +17,7 @@
 #include "manipulatearrays.h"
 
 namespace hybridea {
-extern unsigned long long numConfChecks;
+extern thread_local unsigned long long numConfChecks;
 
 void initializeArrays(int**& nodesByColor, int**& conflicts, int**& tabuStatus,
                       int*& nbcPosition, Graph& g, vector<int>& c, int k) {
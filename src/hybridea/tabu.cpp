@@ -21,7 +21,7 @@
 #include <stdlib.h>
 
 namespace hybridea {
-extern unsigned long long numConfChecks;
+extern thread_local unsigned long long numConfChecks;
 
 using namespace std;
 
@@ -19,7 +19,7 @@
 #include "kempe.h"
 
 namespace hybridea {
-extern unsigned long long numConfChecks;
+extern thread_local unsigned long long numConfChecks;
 
 inline void swap(int& a, int& b) {
   int temp;
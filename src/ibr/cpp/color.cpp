@@ -35,7 +35,7 @@ bool is_k_colorable_exact(int k, const vi& ss, timer t, vi* res) {
 
   for (int i = 0; i < (int)ss.size(); ++i)
     for (int j = i + 1; j < (int)ss.size(); ++j)
-      if (AM[ss[i]][ss[j]]) {
+      if (AM.test(ss[i], ss[j])) {
         btdsatur::setedge(i, j);
         btdsatur::setedge(j, i);
       }
@@ -67,7 +67,7 @@ bool is_k_colorable_heuristic(int k, const vi& ss, timer t, vi* res) {
   fill(g.matrix, g.matrix + g.n * g.n, 0);
   for (int i = 0; i < (int)ss.size(); ++i)
     for (int j = i + 1; j < (int)ss.size(); ++j) {
-      g[i][j] = g[j][i] = AM[ss[i]][ss[j]];
+      g[i][j] = g[j][i] = AM.test(ss[i], ss[j]);
       ++g.nbEdges;
     }
   if (t.secs_left() <= 0) return true;
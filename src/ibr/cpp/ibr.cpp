@@ -38,6 +38,9 @@ bb is_k_vcs(const vvt& v, int which, const timer& t) {
   vi g;
   for (int i = 0; i < n; ++i)
     if (v[i] & which) g.push_back(i);
+  // Vertices of degree < k-1 can always be colored last, so only the
+  // (k-1)-core of the set needs to be tested
+  g = induced_core(AL, g, k - 1);
   if ((int)g.size() < k) return mp(false, true); // surely not critical
   return is_k_vcs(k, g, t);
 }
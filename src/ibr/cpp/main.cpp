@@ -24,14 +24,21 @@
 #include "main.h"
 #include "color.h"
 #include "ibr.h"
+#include "../../dimacs.h"
 #include "../../fmt/ranges.h"
 
 // Local
 namespace {
 bool exited = false;
 bool started = false;
+// AM and AL may be views into its mapping, which the exit handler still reads.
+graph_cache gc;
 } // namespace
 
+// The clique heuristic shared with critcol checks this; IBR always keeps the
+// dense adjacency matrix.
+bool sparse_graph = false;
+
 void read_cmd_line(int argc, char** argv) {
   namespace po = boost::program_options;
   po::variables_map vm;
@@ -50,6 +57,12 @@ void read_cmd_line(int argc, char** argv) {
                      po::value<string>(&output_filename)->default_value(""),
                      "If set, will output the best solution found to given "
                      "file as a list of 0-based vertex indices.");
+  // Graph cache
+  desc.add_options()(
+      "gcache", po::value<string>(&graph_cache_filename)->default_value(""),
+      "Binary graph cache file. If it exists and matches the input file, the "
+      "graph is mapped from it instead of parsing the input; otherwise it is "
+      "written.");
   // k
   desc.add_options()("k,k", po::value<int>(&k)->required(),
                      "Number of colors.");
@@ -121,52 +134,12 @@ void read_cmd_line(int argc, char** argv) {
   verb = vm.count("verbose");
 }
 
-void read_dimacs(const string& filename) {
-  ifstream f(filename);
-  if (not f) {
-    print("Could not open input file.\n");
-    exit(EXIT_FAILURE);
-  }
-  string buf, tmp;
-  int num_edges = 0;
-  bool invalid = false;
-  while (not invalid and getline(f, buf)) {
-    boost::trim_left(buf);
-    if (buf.empty()) continue;
-    if (buf[0] == 'c')
-      continue; // comment
-    else if (buf[0] == 'p') {
-      stringstream ss(buf);
-      ss >> tmp >> tmp >> n >> m;
-      if (boost::to_lower_copy(tmp) != "edge" and
-          boost::to_lower_copy(tmp) != "col") {
-        invalid = true;
-        break;
-      }
-      AL.resize(n);
-      AM.assign(n, vi(n, 0));
-    } else if (buf[0] == 'e') {
-      stringstream ss(buf);
-      int v1, v2;
-      ss >> tmp >> v1 >> v2;
-      assert(inrange(v1, 1, n) and inrange(v2, 1, n));
-      --v1, --v2;
-      if (AM[v1][v2] == 0) {
-        assert(AM[v2][v1] == 0);
-        AL[v1].push_back(v2);
-        AL[v2].push_back(v1);
-        AM[v1][v2] = AM[v2][v1] = 1;
-        ++num_edges;
-      }
-    } else
-      invalid = true;
-  }
-  if (invalid) {
-    print("Error: instance does not seem to be in DIMACS col format.\n");
-    print("Line: {}\n", buf);
-    exit(EXIT_FAILURE);
-  }
-  m = num_edges;
+// Reads the input graph, or maps it from the binary graph cache, if one was
+// given and it matches the input file.
+void read_graph() {
+  load_graph(input_filename, graph_cache_filename, gc, graph_mode::dense);
+  n = gc.raw.n, m = gc.raw.m;
+  AM = move(gc.raw.AM), AL = move(gc.raw.AL);
 }
 
 void print_stats() {
@@ -317,7 +290,7 @@ int main(int argc, char** argv) {
   signal(SIGINT, exit_fun);
   atexit(exit_fun_2);
   read_cmd_line(argc, argv);
-  read_dimacs(input_filename);
+  read_graph();
   for (int i = 0; i < argc; ++i)
     pr("{} ", argv[i]);
   pr("\n");
@@ -22,9 +22,12 @@
 * SOFTWARE.
 */
 #pragma once
+#include "../../bitmat.h"
+#include "../../csr.h"
 #include "../../util.h"
 
-inline vvi AM, AL;
+inline bit_matrix AM;
+inline csr_graph AL;
 inline int n, m, k;
 
 // Parameters
@@ -43,6 +46,7 @@ inline bool
                             // confirmcrittime is a parameter.
 inline double time_limit_secs;
 inline string input_filename;
+inline string graph_cache_filename; // If set, the input graph is cached here
 inline string
     output_filename; // If set, will output the best solution found to given
                      // file as a list of 0-based vertex indices.
@@ -22,87 +22,122 @@
 * SOFTWARE.
 */
 #include "ls.h"
-#include "subgraph.h"
-void ls_impl(subgraph& h, int tenure, int maxnonimpr, int pmin, int pmax,
+#include "arena.h"
+#include "domain.h"
+template <typename I>
+void ls_impl(basic_subgraph<I>& h, int tenure, int maxnonimpr, int pmin, int pmax,
              int pstep) {
-  static vi Vmh;
-  Vmh.clear();
-  sort(begin(ind_n), end(ind_n));
+  auto& ar = local_arena();
+  auto &out = ar.out, &in = ar.in;
+  auto& tabu = ar.tabu;
   sort(begin(h.ss), end(h.ss));
-  assert(is_sorted(begin(h.ss), end(h.ss)));
-  set_difference(begin(ind_n), end(ind_n), begin(h.ss), end(h.ss),
-                 back_inserter(Vmh));
-  assert((int)Vmh.size() == n - h.n);
-  tabu_list tabu(n, tenure);
+  for (int i = 0; i < h.n; ++i)
+    h.pos[h.ss[i]] = i;
+  const bool skip_brooks_pruning = irace_its;
+  const int min_dv = skip_brooks_pruning ? 0 : k - 1;
+  const vb& in_dm = in_domain();
+  const domain& dm = dom();
+  auto boundary = [&](int v) {
+    return not h.contains(v) and h.deg[v] >= min_dv and in_dm[v];
+  };
+  out.reset(h.n), in.reset(h.n);
+  for (int u : h.ss)
+    in.insert(u, h.deg[u]);
+  if (sparse_graph and min_dv > 0) {
+    for (int u : h.ss)
+      for (int v : AL[u])
+        if (boundary(v) and not out.has(v, h.deg[v])) out.insert(v, h.deg[v]);
+  } else {
+    for (int v : dm.vs)
+      if (boundary(v)) out.insert(v, h.deg[v]);
+  }
+  int top = h.n, bot = 0;
+  if (tabu.sz != n or tabu.ten != tenure)
+    tabu = tabu_list(n, tenure);
+  else
+    tabu.reset();
   int nonimpr = 0;
   int pcur = pmin;
+  int64_t moves = 0;
   bool improved = true;
-  const bool skip_brooks_pruning = irace_its;
   while (improved) {
-    static int i = -1, j = -1;
-    if (not inrange(i, 0, (int)Vmh.size() - 1))
-      i = rand_int(0, (int)Vmh.size() - 1);
-    if (not inrange(j, 0, h.n - 1)) j = rand_int(0, h.n - 1);
-    int bst_m = -1, bst_i = -1, bst_j = -1;
-    reservoir_sampling rs;
-    improved = false;
-    for (uint ict = 0; ict < Vmh.size(); ++ict, i = (i + 1) % Vmh.size()) {
-      if (improved) break;
-      int v = Vmh[i];
-      if (tabu.is_tabu(v)) continue;
-      if (not skip_brooks_pruning and h.deg[v] <= k - 2) continue;
-      for (int jct = 0; jct < h.n; ++jct, j = (j + 1) % h.n) {
-        if (improved) break;
-        int u = h.ss[j];
-        if (not skip_brooks_pruning and h.deg[v] - AM[v][u] <= k - 2) continue;
-        if (tabu.is_tabu(u)) continue;
-        int m_try = h.m_cost_swap(j, v);
-        if (bst_m == -1 or bst_m < m_try) {
-          bst_m = m_try, bst_i = i, bst_j = j;
-          rs.reset();
-        } else if (bst_m == m_try and rs.consider()) {
-          bst_m = m_try, bst_i = i, bst_j = j;
+    while (top > 0 and out.b[top].empty())
+      --top;
+    while (bot < h.n - 1 and in.b[bot].empty())
+      ++bot;
+    const int r = rand_int(0, n - 1);
+    int bst_g = nli::min(), bst_v = -1, bst_u = -1;
+    for (int dv = top; dv >= min_dv and dv - bot > bst_g; --dv) {
+      const vi& bv = out.b[dv];
+      for (int a = 0, sa = bv.size(); a < sa and dv - bot > bst_g; ++a) {
+        int v = bv[(a + r) % sa];
+        if (tabu.is_tabu(v)) continue;
+        for (int du = bot; du < h.n and dv - du > bst_g; ++du) {
+          const vi& bu = in.b[du];
+          for (int c = 0, sc = bu.size(); c < sc; ++c) {
+            int u = bu[(c + r) % sc];
+            if (tabu.is_tabu(u)) continue;
+            int a_uv = adjacent(u, v);
+            if (not skip_brooks_pruning and dv - a_uv <= k - 2) continue;
+            if (dv - du - a_uv > bst_g) {
+              bst_g = dv - du - a_uv, bst_v = v, bst_u = u;
+              if (not a_uv) break;
+            }
+          }
         }
-        improved = bst_m > h.m;
       }
     }
-    auto do_move = [&](int i, int j) {
-      assert(not linear_in(h.ss, Vmh[i]));
-      int old = h.ss[j];
-      tabu.add(old);
-      tabu.add(Vmh[i]);
+    improved = bst_g > 0;
+    auto do_move = [&](int v, int u) {
+      assert(not h.contains(v) and h.contains(u));
+      tabu.add(u);
+      tabu.add(v);
       tabu.advance_iter();
-      h.swap(j, Vmh[i]);
-      Vmh[i] = old;
-      ++stats::tot_ls_moves;
+      if (boundary(v)) out.erase(v, h.deg[v]);
+      in.erase(u, h.deg[u]);
+      h.swap(h.pos[u], v, [&](int j, int d) {
+        if (j == u or j == v) return;
+        if (h.contains(j)) {
+          in.move(j, d, h.deg[j]), bot = min(bot, int(h.deg[j]));
+          return;
+        }
+        if (d >= min_dv and in_dm[j]) out.erase(j, d);
+        if (boundary(j)) out.insert(j, h.deg[j]), top = max(top, int(h.deg[j]));
+      });
+      if (boundary(u)) out.insert(u, h.deg[u]), top = max(top, int(h.deg[u]));
+      in.insert(v, h.deg[v]), bot = min(bot, int(h.deg[v]));
+      ++moves;
+    };
+    auto random_outside = [&]() {
+      int v;
+      do
+        v = dm.vs[rand_int(0, dm.n - 1)];
+      while (h.contains(v));
+      return v;
     };
-    if (bst_m == -1) break;
+    if (bst_v == -1) break;
     if (improved) {
-      assert(not linear_in(h.ss, Vmh[bst_i]));
-      assert(inrange(bst_j, 0, (int)h.ss.size() - 1));
-      do_move(bst_i, bst_j);
+      do_move(bst_v, bst_u);
       nonimpr = 0;
     } else {
       ++nonimpr;
       if (nonimpr < maxnonimpr) {
-        do_move(bst_i, bst_j);
+        do_move(bst_v, bst_u);
       } else {
         pcur = pcur + pstep;
         if (pcur > pmax) break;
         for (int p = 0; p < pcur; ++p)
-          do_move(rand_int(0, (int)Vmh.size() - 1),
-                  rand_int(0, (int)h.ss.size() - 1));
+          do_move(random_outside(), h.ss[rand_int(0, h.n - 1)]);
       }
     }
   }
+  stats::tot_ls_moves += moves;
 }
-void ls(subgraph& h) {
+template <typename I> void ls(basic_subgraph<I>& h) {
   TIME_BLOCK("ls");
-  ls_impl(h,
-          n * tenure_mult,
-          max_nonimpr,
-          pmin,
-          pmax_mult * n,
-          pstep
-  );
+  timer lt;
+  ls_impl(h, n * tenure_mult, max_nonimpr, pmin, pmax_mult * n, pstep);
+  stats::add(stats::ls_time, lt.elapsed_secs());
 }
+template void ls(subgraph&);
+template void ls(narrow_subgraph&);
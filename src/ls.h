@@ -23,5 +23,5 @@
 */
 #pragma once       
 #include "main.h"
-struct subgraph;
-void ls(subgraph& h);
+template <typename I> struct basic_subgraph;
+template <typename I> void ls(basic_subgraph<I>& h);
@@ -22,12 +22,15 @@
 * SOFTWARE.
 */
 #include "main.h"
+#include "arena.h"
 #include "cliques/mcqd.h"
 #include "cliques/mntshao.h"
 #include "color.h"
 #include "cons.h"
+#include "domain.h"
 #include "hybridea/main.h"
 #include "ls.h"
+#include "pool.h"
 #include "pproc.h"
 #include "readall.h"
 #include "sm.h"
@@ -37,9 +40,11 @@ namespace {
 bool exited = false;
 vi cur_ss_gen;
 vi random_bfs(int sz) {
-  int start = rand_int(0, n - 1);
+  const domain& d = dom();
+  int start = d.vs[rand_int(0, d.n - 1)];
   vector<int> q;
-  vb visited(n, false);
+  vb visited = in_domain();
+  visited.flip();
   q.push_back(start);
   visited[start] = true;
   vi ans;
@@ -56,63 +61,346 @@ vi random_bfs(int sz) {
         q.push_back(u);
       }
   }
-  return random_sample(sz,ind_n);
+  return random_sample(sz, d.vs);
 }
+struct candidate {
+  vi ss;
+  uint64_t hash;
+  int m;
+};
+struct scratch {
+  candidate cand;
+  vector<candidate> batch;
+  vi alive, held;
+};
+thread_local candidate& cand = per_thread<scratch>().cand;
+thread_local vector<candidate>& batch = per_thread<scratch>().batch;
+thread_local vi& alive = per_thread<scratch>().alive;
+thread_local vi& held = per_thread<scratch>().held;
+// Successive halving over the first nb candidates of the batch: survivors
+// get a heuristic budget of tier_secs, and after each round only the densest
+// 1/tier_eta of those not yet (k-1)-colored go on with tier_eta times the
+// budget. Those left when the budget reaches heu_secs get the full check.
+// The others are held back, and get the full check, latest round first, if
+// none of those is a k-vcs. A failure is sure only if all were checked.
+pair<vi, bool> verify_batch(int nb, int k, timer t) {
+  alive.clear(), held.clear();
+  for (int i = 0; i < nb; ++i)
+    if (auto r = screen_k_vcs(k, batch[i].ss, batch[i].hash)) {
+      if (r->first) return mp(batch[i].ss, true);
+    } else {
+      alive.push_back(i);
+    }
+  sort(begin(alive), end(alive), [](int a, int b) { return batch[a].m > batch[b].m; });
+  for (double b = tier_secs; (int)alive.size() > 1 and b < heu_secs and
+                             not no_heuristic_coloring and not t.timed_out();
+       b *= tier_eta) {
+    int j = 0;
+    for (int i : alive)
+      if (is_k_colorable_heuristic(k - 1, batch[i].ss, timer(b, t)))
+        ++stats::tier_culled;
+      else
+        alive[j++] = i;
+    const int top = (j + tier_eta - 1) / tier_eta;
+    held.insert(begin(held), begin(alive) + top, begin(alive) + j);
+    alive.resize(top);
+  }
+  alive.insert(end(alive), begin(held), end(held));
+  for (int i : alive) {
+    if (t.timed_out()) return mp(vi(), false);
+    ++stats::tier_full;
+    auto [is_vcs, sure] = is_k_vcs(k, batch[i].ss, batch[i].hash, t);
+    if (is_vcs) return mp(batch[i].ss, sure);
+  }
+  return mp(vi(), true);
+}
+}
+template <typename I> void generate_candidate(basic_subgraph<I>& h, int sz, int k) {
+  const domain& d = dom();
+  int x = rand_int(0, 2 * d.m - 1);
+  auto it = lower_bound(begin(d.ind_deg_cum), end(d.ind_deg_cum), x);
+  int i = d.ind_deg[it - begin(d.ind_deg_cum)];
+  ++stats::num_gen_subsets;
+  if (cons_alg == "adddrop") {
+    int lo = (k + 2) + (d.n - k + 2) * 0.25, hi = (k + 2) + (d.n - k + 2) * 0.75;
+    if (sz < lo)
+      cons_add(h, sz, i, cons_alpha);
+    else if (sz > hi)
+      cons_drop(h, sz, cons_alpha);
+    else if (rand_int(lo, hi) < sz)
+      cons_drop(h, sz, cons_alpha);
+    else
+      cons_add(h, sz, i, cons_alpha);
+  } else if (cons_alg == "drop") {
+    cons_drop(h, sz, cons_alpha);
+  } else if (cons_alg == "add") {
+    cons_add(h, sz, i, cons_alpha);
+  }
+  stats::tot_cons_edges += h.m;
+  ls(h);
+  ++stats::num_ls;
+  sort(begin(h.ss), end(h.ss));
+}
+// Builds a candidate into c. Construction and LS run on the 16-bit subgraph
+// of the arena when the ids fit, and only the subset is widened.
+void generate_candidate(candidate& c, int sz, int k) {
+  auto build = [&](auto& h) {
+    generate_candidate(h, sz, k);
+    c.ss.assign(begin(h.ss), end(h.ss)), c.hash = h.hash, c.m = h.m;
+  };
+  if (narrow_ids())
+    build(local_arena().h16);
+  else
+    build(local_arena().h);
+}
+// Candidates are numbered in generation order and handed out to the workers
+// of the pool, each of which builds and verifies its own. As in the
+// sequential loop, the k-VCS with the lowest number wins: once one is found,
+// no later candidate is started, and the checks of later ones are stopped.
+pair<vi, bool> find_k_vcs_parallel(int sz, int k, timer t, int r) {
+  const int nt = pool().size();
+  int next = 1, first = nli::max();
+  vi cur(nt, 0);
+  unique_ptr<atomic<bool>[]> stop(new atomic<bool>[nt]());
+  pair<vi, bool> res(vi(), true);
+  mutex mu;
+  pool().run([&](int w) {
+    timer tw = t;
+    tw.stop_on(stop[w]);
+    while (not t.timed_out()) {
+      int idx;
+      {
+        lock_guard<mutex> lock(mu);
+        if (next > r or next > first) break;
+        idx = cur[w] = next++, stop[w] = false;
+      }
+      generate_candidate(cand, sz, k);
+      auto [is_vcs, sure] = is_k_vcs(k, cand.ss, cand.hash, tw);
+      if (not is_vcs) continue;
+      lock_guard<mutex> lock(mu);
+      if (idx > first) continue;
+      first = idx, res = mp(cand.ss, sure);
+      for (int j = 0; j < nt; ++j)
+        if (cur[j] > idx) stop[j] = true;
+    }
+  });
+  return res;
 }
-pair<vi, bool> find_k_vcs_fixed_size(int sz, int k, timer t) {
-  if (sz == n) return mp(ind_n, true);
+pair<vi, bool> find_k_vcs_fixed_size(int sz, int k, timer t, int r) {
+  const domain& d = dom();
+  if (sz == d.n and d.whole()) return mp(d.vs, true);
+  if (sz == d.n) {
+    auto [is_vcs, sure] = is_k_vcs(k, d.vs, zobrist_hash(d.vs), t);
+    return mp(is_vcs ? d.vs : vi(), sure);
+  }
   ++stats::num_size_att;
-  subgraph h;
-  for (int iter = 1; iter <= R; ++iter) {
+  if (pool().size() > 1 and not no_dense_search and tier_batch == 0) {
+    auto res = find_k_vcs_parallel(sz, k, t, r);
+    if (res.first.size()) ++stats::suc_size_att;
+    return res;
+  }
+  if ((int)batch.size() < tier_batch) batch.resize(tier_batch);
+  bool sure_fail = true;
+  for (int iter = 1, nb = 0; iter <= r; ++iter) {
     if (no_dense_search) {
       vi ss = random_bfs(sz);
-      auto [is_vcs, sure] = is_k_vcs(k, ss, t);
+      auto [is_vcs, sure] = is_k_vcs(k, ss, zobrist_hash(ss), t);
       if (is_vcs) {
         ++stats::suc_size_att;
         return mp(ss, sure);
       }
       continue;
     }
-    int r = rand_int(0, 2 * m - 1);
-    auto it = lower_bound(begin(ind_deg_cum), end(ind_deg_cum), r);
-    int i = ind_deg[it - begin(ind_deg_cum)];
-    if (t.timed_out()) break;
-    ++stats::num_gen_subsets;
-    if (cons_alg == "adddrop") {
-      int lo = (k + 2) + (n - k + 2) * 0.25, hi = (k + 2) + (n - k + 2) * 0.75;
-      if (sz < lo)
-        h = cons_add(sz, i, cons_alpha);
-      else if (sz > hi)
-        h = cons_drop(sz, cons_alpha);
-      else if (rand_int(lo, hi) < sz)
-        h = cons_drop(sz, cons_alpha);
-      else
-        h = cons_add(sz, i, cons_alpha);
-    } else if (cons_alg == "drop") {
-      h = cons_drop(sz, cons_alpha);
-    } else if (cons_alg == "add") {
-      h = cons_add(sz, i, cons_alpha);
+    if (t.timed_out()) {
+      sure_fail = false;
+      break;
     }
-    stats::tot_cons_edges += h.m;
-    ls(h);
-    ++stats::num_ls;
-    sort(begin(h.ss), end(h.ss));
-    auto [is_vcs, sure] = is_k_vcs(k, h.ss, t);
+    const int64_t allocs_gen = stats::thread_allocs;
+    if (tier_batch > 0) {
+      generate_candidate(batch[nb++], sz, k);
+      stats::gen_allocs += stats::thread_allocs - allocs_gen;
+      if (nb < tier_batch and iter < r) continue;
+      auto res = verify_batch(nb, k, t);
+      nb = 0;
+      if (res.first.size()) {
+        ++stats::suc_size_att;
+        return res;
+      }
+      sure_fail = sure_fail and res.second;
+      continue;
+    }
+    generate_candidate(cand, sz, k);
+    const int64_t allocs_check = stats::thread_allocs;
+    auto [is_vcs, sure] = is_k_vcs(k, cand.ss, cand.hash, t);
+    stats::gen_allocs += allocs_check - allocs_gen;
+    stats::check_allocs += stats::thread_allocs - allocs_check;
     if (is_vcs) {
       ++stats::suc_size_att;
-      return mp(move(h.ss), sure);
+      return mp(cand.ss, sure);
     }
   }
-  return mp(vi(), true);
+  return mp(vi(), sure_fail);
+}
+// Failure history of each subset size, per domain. Only sure failures
+// count, and they decay by size_decay at every global iteration; sizes get
+// R / (1 + fails) candidates, and are skipped while fails >= size_skip. A
+// skipped size has no result, and the searches leave their bounds unchanged
+// for it.
+struct size_record {
+  int attempts = 0, successes = 0;
+  double secs = 0.0, fails = 0.0;
+};
+vector<unordered_map<int, size_record>> size_history;
+mutex size_history_mutex;
+optional<pair<vi, bool>> attempt_size(int sz, int k, timer t) {
+  if (sz == dom().n or size_skip <= 0) return find_k_vcs_fixed_size(sz, k, t, R);
+  unique_lock<mutex> lock(size_history_mutex);
+  auto& s = size_history[dom().id][sz];
+  if (s.fails >= size_skip) {
+    ++stats::size_skips;
+    if (verb >= 2)
+      pr("Skipping size {}: {} failures in {} attempts, {:.2f}s\n", sz,
+         s.attempts - s.successes, s.attempts, s.secs);
+    return nullopt;
+  }
+  const int r = ceil(R / (1.0 + s.fails));
+  if (r < R) ++stats::size_cuts;
+  lock.unlock();
+  timer st;
+  auto res = find_k_vcs_fixed_size(sz, k, t, r);
+  if (t.stopped()) return res;
+  lock.lock();
+  ++s.attempts, s.secs += st.elapsed_secs();
+  if (res.first.size())
+    ++s.successes, s.fails = 0.0;
+  else if (res.second)
+    s.fails += 1.0;
+  return res;
+}
+// Size closest to x in [lo, hi] that is not in skipped, or -1 if none.
+int closest_unskipped(int x, int lo, int hi, const unordered_set<int>& skipped) {
+  x = clamp(x, lo, hi);
+  for (int d = 0; x - d >= lo or x + d <= hi; ++d) {
+    if (x - d >= lo and not skipped.count(x - d)) return x - d;
+    if (x + d <= hi and not skipped.count(x + d)) return x + d;
+  }
+  return -1;
+}
+// Result of a search that found no k-vcs smaller than its domain. The whole
+// graph is known to have chromatic number at least k, but a block is not.
+pair<vi, bool> none_found(const domain& d) {
+  return d.whole() ? mp(d.vs, true) : mp(vi(), true);
+}
+// Size of the global best if it surely has chromatic number k, else n + 1.
+int sure_best_size() {
+  lock_guard<mutex> lock(best_mutex);
+  return best_fin_chroma_k ? best_fin.size() : n + 1;
+}
+// Attempts all given sizes at once, one per worker of the pool. A success at
+// some size makes the attempts at larger sizes moot: those are stopped, and
+// they are left without a result, as are skipped sizes. Successes update the
+// global best as soon as they are found.
+vector<optional<pair<vi, bool>>> probe_sizes(const vi& sizes, int k, timer t) {
+  const int np = sizes.size(), nt = pool().size();
+  vector<optional<pair<vi, bool>>> res(np);
+  int next = 0, found = nli::max();
+  vi cur(nt, nli::max());
+  unique_ptr<atomic<bool>[]> stop(new atomic<bool>[nt]());
+  mutex mu;
+  if (np == 0) return res;
+  if (verb >= 2) pr("Probing {} sizes, from {} to {}...\n", np, sizes[0], sizes.back());
+  pool().run([&](int w) {
+    timer tw = t;
+    tw.stop_on(stop[w]);
+    while (not t.timed_out()) {
+      int i;
+      {
+        lock_guard<mutex> lock(mu);
+        do
+          i = next++;
+        while (i < np and sizes[i] > found);
+        if (i >= np) break;
+        cur[w] = sizes[i], stop[w] = false;
+      }
+      auto r = attempt_size(sizes[i], k, tw);
+      lock_guard<mutex> lock(mu);
+      cur[w] = nli::max();
+      if (stop[w]) {
+        ++stats::size_probes_moot;
+        continue;
+      }
+      res[i] = r;
+      if (not r or r->first.empty()) continue;
+      update_global_best(r->first, r->second, false);
+      if (sizes[i] >= found) continue;
+      found = sizes[i];
+      for (int j = 0; j < nt; ++j)
+        if (cur[j] > found) stop[j] = true;
+    }
+  });
+  return res;
+}
+// As find_k_vcs, but probing as many sizes at once as there are threads: the
+// next sizes of the geometric ramp, and then evenly spaced sizes of what is
+// left of the binary search interval.
+pair<vi, bool> find_k_vcs_probing(int k, timer t) {
+  const domain& d = dom();
+  const int np = pool().size();
+  pair<vi, bool> best(vi(), true);
+  int lo = k, hi = -1;
+  vi sizes;
+  for (int sz = k + 2; hi < 0 and not t.timed_out();) {
+    sizes.clear();
+    for (; (int)sizes.size() < np and (sizes.empty() or sizes.back() < d.n);
+         sz = min(d.n, int(sz * mu)))
+      sizes.push_back(sz);
+    auto res = probe_sizes(sizes, k, t);
+    for (int i = 0; i < (int)sizes.size() and hi < 0; ++i)
+      if (res[i] and res[i]->first.size())
+        best = *res[i], hi = sizes[i] - 1;
+      else if (res[i])
+        lo = sizes[i];
+    if (sizes.back() == d.n and hi < 0) return none_found(d);
+  }
+  unordered_set<int> skipped;
+  while (++lo <= hi and not t.timed_out()) {
+    sizes.clear();
+    const int w = hi - lo + 1;
+    for (int j = 1; j <= min(np, w); ++j) {
+      int s = closest_unskipped(w <= np ? lo + j - 1 : lo + (w * j) / (np + 1), lo, hi,
+                                skipped);
+      assert(s < 0 or inrange(s, lo, hi));
+      if (s >= 0 and find(begin(sizes), end(sizes), s) == end(sizes)) sizes.push_back(s);
+    }
+    if (sizes.empty()) break;
+    sort(begin(sizes), end(sizes));
+    auto res = probe_sizes(sizes, k, t);
+    int fail = lo - 1;
+    for (int i = 0; i < (int)sizes.size(); ++i) {
+      if (sizes[i] > hi) continue;
+      if (not res[i])
+        skipped.insert(sizes[i]);
+      else if (res[i]->first.empty())
+        fail = sizes[i];
+      else
+        best = *res[i], hi = sizes[i] - 1;
+    }
+    lo = fail;
+  }
+  return best;
 }
 pair<vi, bool> find_k_vcs(int k, timer t) {
   assert((int)ind_n.size() == n);
-  for (int sz = k + 2, last = k; sz <= n and not t.timed_out();
-       sz = min(n, int(sz * mu))) {
+  const domain& d = dom();
+  if (size_probes and pool().size() > 1 and not local_domain)
+    return find_k_vcs_probing(k, t);
+  for (int sz = k + 2, last = k; sz <= d.n and not t.timed_out();
+       sz = min(d.n, int(sz * mu))) {
+    if (local_domain and sz >= sure_best_size()) break;
     if (verb >= 2) pr("Trying size = {}...\n", sz);
-    vi ss;
-    bool sure_chroma_k;
-    tie(ss, sure_chroma_k) = find_k_vcs_fixed_size(sz, k, t);
+    auto r = attempt_size(sz, k, t);
+    if (not r) continue;
+    auto [ss, sure_chroma_k] = move(*r);
     if (ss.size()) {
       if (verb >= 2) {
         pr("Found k-vcs of size = {} ({}sure_chroma_k)!\n", ss.size(),
@@ -120,12 +408,17 @@ pair<vi, bool> find_k_vcs(int k, timer t) {
       }
       update_global_best(ss, sure_chroma_k, false);
       int lo = last, hi = sz - 1;
+      unordered_set<int> skipped;
       while (sz != k and lo <= hi and not t.timed_out()) {
-        int mid = (lo + hi) / 2;
+        int mid = closest_unskipped((lo + hi) / 2, lo, hi, skipped);
+        if (mid < 0) break;
         if (verb >= 2) pr("Trying size = {} (bs)...\n", mid);
-        vi ss2;
-        bool sure2;
-        tie(ss2, sure2) = find_k_vcs_fixed_size(mid, k, t);
+        auto r2 = attempt_size(mid, k, t);
+        if (not r2) {
+          skipped.insert(mid);
+          continue;
+        }
+        auto& [ss2, sure2] = *r2;
         if (ss2.size())
           hi = mid - 1;
         else
@@ -141,15 +434,44 @@ pair<vi, bool> find_k_vcs(int k, timer t) {
       }
       return mp(ss, sure_chroma_k);
     }
+    if (sz == d.n) break;
     last = sz;
   }
-  return mp(ind_n, true);
+  return none_found(d);
+}
+// Runs find_k_vcs on each block of at least k vertices, the blocks taken by
+// the workers of the pool largest first. The searches share the global best:
+// a block stops its search at sizes no smaller than a sure best. The search
+// goes on in the block of the best result.
+pair<vi, bool> find_k_vcs_blocks(int k, timer t) {
+  const int nd = domains.size();
+  main_domain = &domains[0];
+  if (nd == 1) return find_k_vcs(k, t);
+  if (verb >= 2) pr("Searching {} blocks...\n", nd - 1);
+  vector<pair<vi, bool>> res(nd);
+  atomic<int> next{1};
+  pool().run([&](int) {
+    for (int i; (i = next++) < nd;) {
+      local_domain = &domains[i];
+      res[i] = find_k_vcs(k, t);
+      local_domain = nullptr;
+    }
+  });
+  int best = 0;
+  for (int i = 1; i < nd; ++i)
+    if (res[i].first.size() and
+        (best == 0 or pair(not res[i].second, res[i].first.size()) <
+                          pair(not res[best].second, res[best].first.size())))
+      best = i;
+  main_domain = &domains[best];
+  return best ? res[best] : mp(ind_n, true);
 }
 pair<vi, bool> our_algorithm(int k, timer t) {
   unordered_map<int, pair<vi, bool>> iter_cache;
   unordered_map<vi, pair<vi, bool>> gen_cache;
   const bool use_gen_cache = false;
   using stats::global_iter;
+  size_history.assign(domains.size(), {});
   for (global_iter = 1;
        global_iter <= max_iter and not global_timer.timed_out() and not stats::infeas;
        ++global_iter) {
@@ -163,16 +485,35 @@ pair<vi, bool> our_algorithm(int k, timer t) {
         stats::fin_best_1st_phase = best_fin.size();
       } else {
         TIME_BLOCK("iter = 1");
-        tie(ss, chroma_k) = find_k_vcs(k, t);
+        tie(ss, chroma_k) = find_k_vcs_blocks(k, t);
         stats::gen_best_1st_phase = best_gen.size();
         stats::fin_best_1st_phase = best_fin.size();
         if ((int)ss.size() == n) break;
       }
     } else {
       if (global_iter - global_iter_last_improve > imax) break;
+      for (auto& h : size_history)
+        for (auto& [sz, s] : h)
+          s.fails *= size_decay;
       TIME_BLOCK("iter >= 1");
-      const int ub = min(n, (int)ceil(xi * (double)best_gen.size()));
-      if (inrange(ub, k + 2, n)) {
+      const int ub = min(dom().n, (int)ceil(xi * (double)best_gen.size()));
+      if (inrange(ub, k + 2, dom().n) and size_probes and pool().size() > 1) {
+        bool fail = false;
+        for (int sz = ub; sz >= k + 2 and not fail and not t.timed_out();) {
+          const int top = sz;
+          vi sizes;
+          for (; sz >= k + 2 and (int)sizes.size() < pool().size(); --sz)
+            if (not iter_cache.count(sz)) sizes.push_back(sz);
+          auto res = probe_sizes(sizes, k, t);
+          for (int i = 0; i < (int)sizes.size(); ++i)
+            if (res[i] and res[i]->first.size())
+              iter_cache[sizes[i]] = *res[i];
+            else if (res[i])
+              fail = true;
+          for (int s = top; s > sz; --s)
+            if (iter_cache.count(s)) tie(ss, chroma_k) = iter_cache[s];
+        }
+      } else if (inrange(ub, k + 2, dom().n)) {
         for (int sz = ub, i = 1; sz >= k + 2; --sz, ++i) {
           if (verb >= 2) pr("Trying size {} (iteration {}.{})...\n", sz, global_iter, i);
           auto it = iter_cache.find(sz);
@@ -181,9 +522,9 @@ pair<vi, bool> our_algorithm(int k, timer t) {
             tie(ss, chroma_k) = it->second;
             if (verb >= 2) pr("Already cached! ({}chroma_k)!\n", chroma_k ? "" : "not ");
           } else {
-            vi ss2;
-            bool sure2;
-            tie(ss2, sure2) = find_k_vcs_fixed_size(sz, k, t);
+            auto r = attempt_size(sz, k, t);
+            if (not r) continue;
+            auto& [ss2, sure2] = *r;
             if (ss2.empty()) break;
             iter_cache[sz] = mp(ss2, sure2);
             swap(ss2, ss), swap(sure2, chroma_k);
@@ -283,21 +624,27 @@ void check_criticality() {
     stats::confirmed_crit = best_fin_crit;
     timer confirm_crit_timer(confirm_crit_timelimit);
     if (do_force_confirm || (stats::confirmed_chroma and not best_fin_crit)) {
-      stats::confirmed_crit = true;
-      for (int i : best_fin) {
-        if (confirm_crit_timer.timed_out()) {
-          stats::confirmed_crit = false;
-          break;
+      // The vertices are checked by the workers of the pool, and all checks
+      // stop as soon as one vertex can't be shown critical.
+      const int sz = best_fin.size();
+      const double tl_each = max(0.5, double(sz) / confirm_crit_timelimit);
+      atomic<int> next{0};
+      atomic<bool> failed{false};
+      pool().run([&](int) {
+        for (int i; not failed and (i = next++) < sz;) {
+          if (confirm_crit_timer.timed_out()) {
+            failed = true;
+            break;
+          }
+          vi v = best_fin;
+          v.erase(begin(v) + i);
+          timer tmr(tl_each);
+          tmr.stop_on(failed);
+          bool is_kc = is_k_colorable_exact(k - 1, v, tmr);
+          if (not is_kc or tmr.timed_out()) failed = true;
         }
-        vi v = best_fin;
-        remove(begin(v), end(v), i);
-        v.pop_back();
-        const double tl_each = max(0.5, double(best_fin.size()) / confirm_crit_timelimit);
-        timer tmr(tl_each);
-        bool is_kc = is_k_colorable_exact(k - 1, v, tmr);
-        stats::confirmed_crit = stats::confirmed_crit and is_kc and not tmr.timed_out();
-        if (not stats::confirmed_crit) break;
-      }
+      });
+      stats::confirmed_crit = not failed;
     }
     stats::confirm_crit_time = confirm_crit_timer.elapsed_secs();
     if (verb >= 1) {
@@ -340,13 +687,13 @@ void do_irace_its() {
       if (t.timed_out()) break;
       int lo = n * 0.25, hi = n * 0.75;
       if (k < lo)
-        h = cons_add(k, i, cons_alpha);
+        cons_add(h, k, i, cons_alpha);
       else if (k > hi)
-        h = cons_drop(k, cons_alpha);
+        cons_drop(h, k, cons_alpha);
       else if (rand_int(lo, hi) < k)
-        h = cons_drop(k, cons_alpha);
+        cons_drop(h, k, cons_alpha);
       else
-        h = cons_add(k, i, cons_alpha);
+        cons_add(h, k, i, cons_alpha);
       ls(h);
       best_m = max(best_m, h.m);
     }
@@ -355,13 +702,41 @@ void do_irace_its() {
   }
   print("{}", res);
 }
+vi greedy_max_clique(int k, timer t) {
+  vi best, cl, cand, nxt;
+  for (int v : ind_deg) {
+    if (AL.degree(v) + 1 <= (int)best.size() or t.timed_out()) break;
+    cl.assign(1, v);
+    cand.assign(begin(AL[v]), end(AL[v]));
+    while (not cand.empty()) {
+      const csr_graph::range r{cand.data(), cand.data() + cand.size()};
+      int u = cand[0], u_score = -1;
+      for (int w : cand) {
+        int w_score = intersect_count(AL[w], r);
+        if (w_score > u_score) u = w, u_score = w_score;
+      }
+      cl.push_back(u);
+      nxt.clear();
+      set_intersection(begin(cand), end(cand), begin(AL[u]), end(AL[u]),
+                       back_inserter(nxt));
+      swap(cand, nxt);
+    }
+    if (cl.size() > best.size()) best = cl;
+    if ((int)best.size() >= k) break;
+  }
+  return best;
+}
+vi max_clique(int k, timer t) {
+  if (sparse_graph) return greedy_max_clique(k, t);
+  return hao_mnts_max_clique(ind_n, k, t);
+}
 void do_just_exact_coloring() {
-  int lb = max(k, (int)size(hao_mnts_max_clique(ind_n, k, timer(clique_alg_time_1st))));
+  int lb = max(k, (int)size(max_clique(k, timer(clique_alg_time_1st))));
   int colors = color_exactly(ind_n, global_timer, lb);
   pr("{} {} {}\n", instance_name, global_timer.elapsed_secs(), colors);
 }
 void do_just_heuristic_coloring() {
-  int lb = max(k, (int)size(hao_mnts_max_clique(ind_n, k, timer(clique_alg_time_1st))));
+  int lb = max(k, (int)size(max_clique(k, timer(clique_alg_time_1st))));
   int colors = color_heuristically(ind_n, global_timer, lb);
   pr("{} {} {}\n", instance_name, global_timer.elapsed_secs(), colors);
 }
@@ -387,8 +762,8 @@ vi mcqd_max_clique(const vi& ind, timer t) {
   for (int i = 0; i < n; ++i)
     conn[i] = new bool[n];
   for (int i = 0; i < n; ++i)
-    for (int j = 0; j < n; ++j)
-      conn[i][j] = AM[ind[i]][ind[j]];
+    fill(conn[i], conn[i] + n, false);
+  for_each_induced_edge(ind, [&](int i, int j) { conn[i][j] = conn[j][i] = true; });
   Maxclique m(conn, n, t);
   int* qmax;
   int qsize;
@@ -404,6 +779,7 @@ vi mcqd_max_clique(const vi& ind, timer t) {
 }
 int main(int argc, char** argv) {
   cmd_line(argc, argv);
+  pool().start(num_threads, random_seed);
   if (normal_run) {
     signal(SIGINT, exit_fun);
     atexit(exit_fun_2);
@@ -413,6 +789,7 @@ int main(int argc, char** argv) {
   }
   bool do_preprocess = normal_run;
   read_dimacs(input_filename, do_preprocess);
+  build_domains(k);
   if (irace_its) {
     do_irace_its();
     return EXIT_SUCCESS;
@@ -431,7 +808,7 @@ int main(int argc, char** argv) {
   if (verb >= 1) pr("\n");
   vi clique;
   try {
-    clique = hao_mnts_max_clique(ind_n, k, timer(clique_alg_time_1st));
+    clique = max_clique(k, timer(clique_alg_time_1st));
   } catch (std::exception& e) {
     if (verb >= 1) pr("Exception on max-clique: {}\n", e.what());
     clique.assign(1, 0);
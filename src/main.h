@@ -22,10 +22,15 @@
 * SOFTWARE.
 */
 #pragma once       
+#include "bitmat.h"
+#include "csr.h"
 #include "stats.h"
 #include "util.h"
 inline string input_filename;
 inline string output_filename;
+inline string graph_cache_filename;
+inline string adjacency_mode;
+inline string relabel_order;
 inline double time_limit_secs;
 inline int k;
 inline size_t random_seed;
@@ -44,6 +49,15 @@ inline double pmax_mult;
 inline int pstep;
 inline double clique_alg_time_1st;
 inline double cons_alpha;
+inline int drop_snapshots;
+inline int tier_batch;
+inline double tier_secs;
+inline int tier_eta;
+inline double size_skip;
+inline double size_decay;
+inline int num_threads;
+inline bool size_probes;
+inline bool portfolio;
 inline double confirm_crit_timelimit;
 inline bool do_confirm_criticality;
 inline bool do_force_confirm;
@@ -65,11 +79,10 @@ inline vi ind_n;
 inline vi ind_deg;
 inline vi ind_deg_cum;
 inline int n_ori, m_ori;
-inline vvi AM_ori;
-inline vvi AL_ori;
 inline int n, m;
-inline vvi AM;
-inline vvi AL;
+inline bit_matrix AM;
+inline csr_graph AL;
+inline bool sparse_graph = false;
 inline vi vmap;
 inline vi best_fin;
 inline bool best_fin_chroma_k = true;
@@ -79,7 +92,49 @@ inline bool best_gen_sure = true;
 inline bool did_postproc = false;
 inline timer global_timer;
 inline int global_iter_last_improve = 0;
+inline mutex best_mutex;
+struct induced_scratch {
+  vi pos;
+};
+inline bool adjacent(int u, int v) {
+  return sparse_graph ? AL.has_edge(u, v) : AM.test(u, v);
+}
+inline int count_adjacent(int v, const bit_set& s) {
+  if (not sparse_graph) return AM.count(v, s);
+  int c = 0;
+  for (int u : AL[v])
+    c += s.test(u);
+  return c;
+}
+template <typename F>
+inline void for_each_adjacent(int v, F f) {
+  if (sparse_graph)
+    for (int u : AL[v])
+      f(u);
+  else
+    AM.for_each(v, f);
+}
+template <typename F>
+inline void for_each_induced_edge(const vi& ss, F f) {
+  const int sz = ss.size();
+  if (not sparse_graph) {
+    for (int i = 0; i < sz; ++i)
+      for (int j = i + 1; j < sz; ++j)
+        if (AM.test(ss[i], ss[j])) f(i, j);
+    return;
+  }
+  static thread_local vi& pos = per_thread<induced_scratch>().pos;
+  pos.resize(n, -1);
+  for (int i = 0; i < sz; ++i)
+    pos[ss[i]] = i;
+  for (int i = 0; i < sz; ++i)
+    for (int u : AL[ss[i]])
+      if (pos[u] > i) f(i, pos[u]);
+  for (int v : ss)
+    pos[v] = -1;
+}
 inline void update_global_best(const vi& ss, bool chroma_k, bool crit) {
+  lock_guard<mutex> lock(best_mutex);
   if (((int)best_fin.size() == n and
        inrange((int)ss.size(), 1, (int)best_fin.size() - 1)) or
       mt(not chroma_k, not crit, ss.size()) <
@@ -103,17 +158,20 @@ inline void update_global_best(const vi& ss, bool chroma_k, bool crit) {
 inline void sort_by_degree(vi& ss) {
   vi deg(n, 0);
   shuffle(begin(ind_n), end(ind_n), rng);
-  for (uint i = 0; i < ss.size(); ++i) {
-    for (uint j = 0; j < ss.size(); ++j)
-      deg[ss[i]] += AM[ss[i]][ss[j]];
-  }
+  bit_set in_ss(n);
+  for (int v : ss)
+    in_ss.set(v);
+  for (int v : ss)
+    deg[v] = count_adjacent(v, in_ss);
   sort(begin(ss), end(ss),
        [&](int i, int j) { return tie(deg[i], ind_n[i]) > tie(deg[j], ind_n[j]); });
 }
 inline int count_edges(const vi& ss) {
+  bit_set in_ss(n);
+  for (int v : ss)
+    in_ss.set(v);
   int m = 0;
-  for (uint i = 0; i < ss.size(); ++i)
-    for (uint j = i + 1; j < ss.size(); ++j)
-      m += AM[ss[i]][ss[j]];
-  return m;
+  for (int v : ss)
+    m += count_adjacent(v, in_ss);
+  return m / 2;
 }
@@ -0,0 +1,76 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#pragma once       
+#include "util.h"
+template <typename T> struct mapped_vector {
+  mapped_vector() = default;
+  mapped_vector(const mapped_vector& o) { *this = o; }
+  mapped_vector(mapped_vector&& o) { *this = move(o); }
+  mapped_vector& operator=(const mapped_vector& o) {
+    if (this == &o) return *this;
+    if (o.is_view())
+      v.clear(), p = o.p;
+    else
+      v = o.v, p = v.data();
+    sz = o.sz;
+    return *this;
+  }
+  mapped_vector& operator=(mapped_vector&& o) {
+    bool view = o.is_view();
+    v = move(o.v), p = view ? o.p : v.data(), sz = o.sz;
+    o.v.clear(), o.p = nullptr, o.sz = 0;
+    return *this;
+  }
+  void assign(size_t n, const T& x) { v.assign(n, x), sync(); }
+  void resize(size_t n) { v.resize(n), sync(); }
+  void view(const T* q, size_t n) { vector<T>().swap(v), p = q, sz = n; }
+  bool is_view() const { return sz and p != v.data(); }
+  size_t size() const { return sz; }
+  bool empty() const { return sz == 0; }
+  const T* data() const { return p; }
+  T* data() { return assert(not is_view()), v.data(); }
+  const T& operator[](size_t i) const { return p[i]; }
+  T& operator[](size_t i) { return assert(not is_view()), v[i]; }
+  const T* begin() const { return p; }
+  const T* end() const { return p + sz; }
+  T* begin() { return data(); }
+  T* end() { return data() + sz; }
+private:
+  void sync() { p = v.data(), sz = v.size(); }
+  vector<T> v;
+  const T* p = nullptr;
+  size_t sz = 0;
+};
+struct mapped_file {
+  mapped_file() = default;
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  ~mapped_file() { close(); }
+  bool open(const string& filename);
+  void close();
+  const char* data() const { return base; }
+  size_t size() const { return len; }
+  const char* base = nullptr;
+  size_t len = 0;
+};
@@ -0,0 +1,61 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "pool.h"
+#include "stats.h"
+namespace {
+thread_local const thread_pool* inside = nullptr;
+}
+void thread_pool::start(int threads, size_t seed) {
+  this->threads = max(1, threads);
+  for (int id = 1; id < this->threads; ++id)
+    thread(&thread_pool::work, this, id, seed).detach();
+}
+void thread_pool::run(const function<void(int)>& f) {
+  if (threads == 1 or inside == this) return f(0);
+  unique_lock<mutex> lock(mu);
+  job = &f, running = threads - 1, ++generation;
+  job_cv.notify_all();
+  lock.unlock();
+  auto outer = inside;
+  inside = this;
+  f(0);
+  inside = outer;
+  lock.lock();
+  done_cv.wait(lock, [&] { return running == 0; });
+}
+void thread_pool::work(int id, size_t seed) {
+  rng.seed(seed + id);
+  inside = this;
+  for (int seen = 0;;) {
+    unique_lock<mutex> lock(mu);
+    job_cv.wait(lock, [&] { return generation != seen; });
+    seen = generation;
+    auto f = job;
+    lock.unlock();
+    (*f)(id);
+    stats::flush_allocs();
+    lock.lock();
+    if (--running == 0) done_cv.notify_all();
+  }
+}
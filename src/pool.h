@@ -0,0 +1,44 @@
+/*
+* A new heuristic for finding verifiable k-vertex-critical subgraphs
+* 
+* Copyright (c) 2022 Alex Gliesch, Marcus Ritt
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPY lRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#pragma once       
+#include "util.h"
+// Worker threads that all run the same job at once. The calling thread takes
+// part as worker 0. A run from inside a job of the same pool is done by the
+// calling thread alone, so jobs must not rely on all workers taking part.
+class thread_pool {
+  int threads = 1, running = 0, generation = 0;
+  const function<void(int)>* job = nullptr;
+  mutex mu;
+  condition_variable job_cv, done_cv;
+  void work(int id, size_t seed);
+public:
+  void start(int threads, size_t seed);
+  int size() const { return threads; }
+  void run(const function<void(int)>& f);
+};
+// Never destroyed, since the workers block on it until the process exits.
+inline thread_pool& pool() {
+  static thread_pool* p = new thread_pool;
+  return *p;
+}
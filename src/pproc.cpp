@@ -23,6 +23,7 @@
 */
 #include "pproc.h"
 #include "color.h"
+#include "pool.h"
 void mark_trivially_critical(const vi& ss, const vi& color, vb& crit, int k) {
   vi in_ss(n, -1);
   vi color_seen(k, -1);
@@ -61,17 +62,20 @@ void mark_trivially_critical(const vi& ss, const vi& color, vb& crit, int k) {
 int choose_v_sun(const vi& ss, const vb& crit) {
   int b = -1, b_score = 0;
   reservoir_sampling rs;
+  bit_set in_ss(n), in_crit(n);
+  for (int j : ss) {
+    assert(inrange(j, 0, n - 1));
+    in_ss.set(j);
+    if (crit[j]) in_crit.set(j);
+  }
   for (int i = 0; i < (int)ss.size(); ++i) {
     assert(inrange(ss[i], 0, n - 1));
     if (not crit[ss[i]]) {
-      int i_score = 0;
-      for (int j : ss) {
-        assert(inrange(j, 0, n - 1));
-        if (AM[ss[i]][j]) i_score += (crit[j] ? m : 1);
-      }
+      int i_score =
+          count_adjacent(ss[i], in_ss) + (m - 1) * count_adjacent(ss[i], in_crit);
       if (b == -1 or i_score < b_score or (i_score == b_score and rs.consider())) {
-        if (i_score != b_score) rs.reset();
-        b = i, i_score = b_score;
+        if (b == -1 or i_score != b_score) rs.reset(1.0);
+        b = i, b_score = i_score;
       }
     }
   }
@@ -82,6 +86,93 @@ int choose_lexi(const vi& ss, const vb& crit) {
     if (not crit[ss[i]]) return i;
   return -1;
 }
+namespace {
+// Returns up to p non-critical vertices of ss, in the order choose_v_sun would
+// pick them, after those of first that are still non-critical.
+vi choose_many_sun(const vi& ss, const vb& crit, int p, const vi& first) {
+  vi res;
+  for (int v : first)
+    if (not crit[v] and (int)res.size() < p) res.push_back(v);
+  bit_set in_ss(n), in_crit(n), in_res(n);
+  for (int v : ss) {
+    in_ss.set(v);
+    if (crit[v]) in_crit.set(v);
+  }
+  for (int v : res)
+    in_res.set(v);
+  vector<pair<int, int>> sc;
+  for (int v : ss)
+    if (not crit[v] and not in_res.test(v))
+      sc.emplace_back(count_adjacent(v, in_ss) + (m - 1) * count_adjacent(v, in_crit), v);
+  shuffle(begin(sc), end(sc), rng);
+  stable_sort(begin(sc), end(sc),
+              [](auto& a, auto& b) { return a.first < b.first; });
+  for (int i = 0; i < (int)sc.size() and (int)res.size() < p; ++i)
+    res.push_back(sc[i].second);
+  return res;
+}
+struct removal {
+  int v;
+  vi ss, color;
+  bool colorable, sure;
+};
+// Tests the removal of the top p candidates at once, one per worker of the
+// pool. The first one whose removal leaves a k-vcs is committed; the others
+// were tested with it still in ss, so they are retested in the next round.
+// Every coloring found marks critical vertices, which stay critical in any
+// subset of ss.
+pair<bool, bool> reduce_subset_in_parallel(int k, vi& ss, bool chroma_k, vb& surely_crit,
+                                           timer t) {
+  bool crit = true;
+  uint64_t hash = zobrist_hash(ss);
+  vi retry;
+  vector<removal> tests;
+  while (not t.timed_out()) {
+    vi cand = choose_many_sun(ss, surely_crit, pool().size(), retry);
+    if (cand.empty()) break;
+    tests.resize(cand.size());
+    atomic<int> next{0};
+    pool().run([&](int) {
+      for (int j; (j = next++) < (int)cand.size();) {
+        auto& r = tests[j];
+        r.v = cand[j], r.ss = ss;
+        r.ss.erase(find(begin(r.ss), end(r.ss), r.v));
+        tie(r.colorable, r.sure) =
+            check_colorability(k - 1, r.ss, hash ^ zobrist_key(r.v), t, &r.color);
+      }
+    });
+    if (t.timed_out()) break;
+    retry.clear();
+    bool removed = false;
+    for (auto& r : tests) {
+      crit = crit and r.sure;
+      if (r.colorable) {
+        bool ok = r.color.size() == r.ss.size() and
+                  all_of(begin(r.color), end(r.color),
+                         [&](int c) { return inrange(c, 0, k - 1); });
+        if (ok)
+          mark_trivially_critical(r.ss, r.color, surely_crit, k - 1);
+        else if (not r.color.empty())
+          ++stats::color_not_ok;
+        surely_crit[r.v] = true;
+      } else if (not removed) {
+        removed = true;
+        ss = move(r.ss);
+        chroma_k = r.sure;
+        hash ^= zobrist_key(r.v);
+        if (verb >= 1)
+          pr("Removed {} (chroma_k: {}), reduced ss size {}->{}\n", r.v, r.sure,
+             ss.size() + 1, ss.size());
+        update_global_best(ss, chroma_k, false);
+      } else {
+        retry.push_back(r.v);
+        ++stats::pp_retries;
+      }
+    }
+  }
+  return mp(chroma_k, crit);
+}
+} // namespace
 pair<bool, bool> reduce_subset_one_by_one(int k, vi& ss, bool chroma_k_bef, timer t) {
   vi color;
   vb surely_crit(n, false);
@@ -98,8 +189,11 @@ pair<bool, bool> reduce_subset_one_by_one(int k, vi& ss, bool chroma_k_bef, time
     pr("Trying to reduce subset of size {}, chroma_k_bef: {}...\n", ss.size(),
        chroma_k_bef);
   if ((int)ss.size() == k) return mp(true, true);
+  if (pool().size() > 1)
+    return reduce_subset_in_parallel(k, ss, chroma_k_bef, surely_crit, t);
   bool chroma_k = chroma_k_bef;
   bool crit = true;
+  uint64_t hash = zobrist_hash(ss);
   while (not t.timed_out()) {
     int i = choose_v_sun(ss, surely_crit);
     if (i == -1) break;
@@ -107,7 +201,8 @@ pair<bool, bool> reduce_subset_one_by_one(int k, vi& ss, bool chroma_k_bef, time
     assert(not surely_crit[v]);
     swap(ss[i], ss.back());
     ss.pop_back();
-    auto [colorable, sure] = check_colorability(k - 1, ss, t, &color);
+    auto [colorable, sure] =
+        check_colorability(k - 1, ss, hash ^ zobrist_key(v), t, &color);
     if (t.timed_out()) break;
     crit = crit and sure;
     if (colorable) {
@@ -117,12 +212,13 @@ pair<bool, bool> reduce_subset_one_by_one(int k, vi& ss, bool chroma_k_bef, time
       ss.push_back(v);
       swap(ss[i], ss.back());
       ++i;
-      if (not ok) {
+      if (not ok and not color.empty()) {
         ++stats::color_not_ok;
         continue;
       }
     } else {
       chroma_k = sure;
+      hash ^= zobrist_key(v);
       if (verb >= 1)
         pr("Removed {} (chroma_k: {}), reduced ss size {}->{}\n", v, sure, ss.size() + 1,
            ss.size());
@@ -27,6 +27,7 @@
 #include <unistd.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/functional/hash.hpp>
@@ -40,6 +41,7 @@
 #include <chrono>
 #include <ciso646>
 #include <cmath>
+#include <condition_variable>
 #include <csignal>
 #include <ctime>
 #include <fstream>
@@ -49,6 +51,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <ostream>
@@ -57,6 +60,7 @@
 #include <sstream>
 #include <stack>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -26,13 +26,13 @@
 #include <ctime>
 #include <random>
 using namespace std;
-inline mt19937 rng;
+inline thread_local mt19937 rng;
 inline int rand_int(int from, int to) {
- static uniform_int_distribution<int> d;
+ static thread_local uniform_int_distribution<int> d;
  return d(rng, decltype(d)::param_type{from, to});
 }
 inline double rand_double(double from, double to) {
- static std::uniform_real_distribution<double> d;
+ static thread_local std::uniform_real_distribution<double> d;
  return d(rng, decltype(d)::param_type{from, to});
 }
 inline bool rand_bool() { return (bool)rand_int(0, 1); }
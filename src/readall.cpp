@@ -22,6 +22,8 @@
 * SOFTWARE.
 */
 #include "readall.h"
+#include "dimacs.h"
+#include "gcache.h"
 #include "main.h"
 #include "stats.h"
 #include <boost/any.hpp>
@@ -37,6 +39,22 @@ void cmd_line(int argc, char** argv) {
                      "chromatic number is confirmed) to the given filename, as "
                      "a list of 0-based vertex indices.");
   desc.add_options()("k,k", po::value<int>(&k)->required(), "Number of colors.");
+  desc.add_options()(
+      "gcache", po::value<string>(&graph_cache_filename)->default_value(""),
+      "Binary graph cache file. If it exists and matches the input file, the "
+      "graph (and its pre-processed version for this k, if present) is mapped "
+      "from it instead of parsing the input; otherwise it is written.");
+  desc.add_options()(
+      "adjacency", po::value<string>(&adjacency_mode)->default_value("auto"),
+      "Adjacency representation, in [auto,dense,sparse]. Dense keeps an n x n "
+      "bit matrix; sparse only keeps sorted adjacency lists, for very large "
+      "sparse graphs. Auto picks sparse when n > 4096 and the average degree is "
+      "below n/64.");
+  desc.add_options()(
+      "relabel", po::value<string>(&relabel_order)->default_value("none"),
+      "Vertex relabeling applied after pre-processing, in "
+      "[none,degeneracy,rcm]. Both orders place densely connected vertices "
+      "next to each other, which improves memory locality.");
   desc.add_options()("time,t", po::value<double>(&time_limit_secs)->default_value(600),
                      "Time limit, in seconds.");
   desc.add_options()("heutime", po::value<double>(&heu_secs)->default_value(0.5),
@@ -64,6 +82,42 @@ void cmd_line(int argc, char** argv) {
                      "Constructive algorithm, in [add,drop,adddrop].");
   desc.add_options()("alpha", po::value<double>(&cons_alpha)->default_value(0.1),
                      "Alpha parameter of the constructive algorithm.");
+  desc.add_options()("dropsnaps", po::value<int>(&drop_snapshots)->default_value(8),
+                     "Number of intermediate subsets of sizes n/2, n/4, ... kept "
+                     "by the drop constructive algorithm, which resumes from "
+                     "one of them instead of from the whole graph. The most "
+                     "recent ones are kept, and one drop in this many starts "
+                     "a level higher to refresh them. Use 0 to disable.");
+  desc.add_options()("tierbatch", po::value<int>(&tier_batch)->default_value(0),
+                     "If positive, candidates of a size attempt are verified in "
+                     "batches of this size by successive halving, instead of "
+                     "one at a time with the full coloring budget.");
+  desc.add_options()("tiersecs", po::value<double>(&tier_secs)->default_value(0.01),
+                     "Heuristic coloring budget of the first successive halving "
+                     "round, in seconds.");
+  desc.add_options()("tiereta", po::value<int>(&tier_eta)->default_value(3),
+                     "Successive halving keeps the densest 1/tiereta of the "
+                     "survivors of each round and multiplies their budget by "
+                     "tiereta.");
+  desc.add_options()("sizeskip", po::value<double>(&size_skip)->default_value(2.0),
+                     "Subset sizes whose decayed failure count reaches this "
+                     "value are skipped; below it, they get R/(1+failures) "
+                     "candidates. Use 0 to disable.");
+  desc.add_options()("sizedecay", po::value<double>(&size_decay)->default_value(0.75),
+                     "Factor applied to the failure count of each subset size "
+                     "at every global iteration.");
+  desc.add_options()("threads", po::value<int>(&num_threads)->default_value(1),
+                     "Number of threads. With more than one, the candidates of "
+                     "a size attempt are built and verified in parallel, as "
+                     "are the vertices checked by --confirmcrit.");
+  desc.add_options()(
+      "sizeprobes", po::bool_switch(&size_probes)->default_value(false),
+      "With more than one thread, attempt several subgraph sizes at once "
+      "instead of the candidates of a single size.");
+  desc.add_options()(
+      "portfolio", po::bool_switch(&portfolio)->default_value(false),
+      "Run the exact and the heuristic coloring algorithms at the same time, "
+      "each on its own thread, and keep the first answer.");
   desc.add_options()("tenure", po::value<double>(&tenure_mult)->default_value(0.1),
                      "Tabu tenure.");
   desc.add_options()("imaxits", po::value<int>(&max_nonimpr)->default_value(10000),
@@ -150,6 +204,16 @@ void cmd_line(int argc, char** argv) {
       throw po::validation_error(po::validation_error::invalid_option_value, "consalg",
                                  cons_alg);
     }
+    if (adjacency_mode != "auto" and adjacency_mode != "dense" and
+        adjacency_mode != "sparse") {
+      throw po::validation_error(po::validation_error::invalid_option_value, "adjacency",
+                                 adjacency_mode);
+    }
+    if (relabel_order != "none" and relabel_order != "degeneracy" and
+        relabel_order != "rcm") {
+      throw po::validation_error(po::validation_error::invalid_option_value, "relabel",
+                                 relabel_order);
+    }
     if (random_seed == 0) random_seed = unique_random_seed();
     rng.seed(random_seed);
     normal_run =
@@ -173,101 +237,103 @@ void cmd_line(int argc, char** argv) {
     exit(EXIT_SUCCESS);
   }
 }
-void read_dimacs(const string& filename, bool do_preprocess) {
-  ifstream f(filename);
-  if (not f) {
-    print("Could not open input file.\n");
-    exit(EXIT_FAILURE);
-  }
-  string buf, tmp;
-  int num_edges = 0;
-  bool invalid = false;
-  while (not invalid and getline(f, buf)) {
-    boost::trim_left(buf);
-    if (buf.empty()) continue;
-    if (buf[0] == 'c') {
-      if ((irace_its and boost::starts_with(buf, "c k ")) or
-          (irace and boost::starts_with(buf, "c Random graph,"))) {
-        vs s;
-        boost::split(s, buf, boost::is_any_of(" "));
-        k = stoi(s.back());
-      }
-      continue;
-    } else if (buf[0] == 'p') {
-      stringstream ss(buf);
-      ss >> tmp >> tmp >> n >> m;
-      if (boost::to_lower_copy(tmp) != "edge" and boost::to_lower_copy(tmp) != "col") {
-        invalid = true;
-        break;
-      }
-      AL.resize(n);
-      AM.assign(n, vi(n, 0));
-    } else if (buf[0] == 'e') {
-      stringstream ss(buf);
-      int v1, v2;
-      ss >> tmp >> v1 >> v2;
-      assert(inrange(v1, 1, n) and inrange(v2, 1, n));
-      --v1, --v2;
-      if (AM[v1][v2] == 0) {
-        assert(AM[v2][v1] == 0);
-        AL[v1].push_back(v2);
-        AL[v2].push_back(v1);
-        AM[v1][v2] = AM[v2][v1] = 1;
-        ++num_edges;
-      }
-    } else
-      invalid = true;
+namespace {
+graph_cache gcache;
+void install(graph_block& g, bool keep) {
+  graph_block c;
+  if (keep) {
+    c.AL = g.AL, c.vmap = g.vmap, c.ind_deg = g.ind_deg, c.ind_deg_cum = g.ind_deg_cum;
+    if (g.AM.w.is_view())
+      c.AM = g.AM;
+    else
+      c.AM = move(g.AM);
+  } else {
+    c = move(g);
   }
-  if (invalid) {
-    print("Error: instance {} does not seem to be in DIMACS col format.\n", filename);
-    print("Line: {}\n", buf);
-    exit(EXIT_FAILURE);
-  }
-  m = num_edges;
-  if (verb >= 1) pr("--n: {}, m: {}\n", n, m);
-  vmap.resize(n);
-  iota(begin(vmap), end(vmap), 0);
-  n_ori = n, m_ori = m, AM_ori = AM, AL_ori = AL;
-  if (do_preprocess) preprocess();
+  n = g.n, m = g.m;
+  AM = move(c.AM), AL = move(c.AL);
+  vmap = move(c.vmap), ind_deg = move(c.ind_deg), ind_deg_cum = move(c.ind_deg_cum);
+}
+}
+void read_dimacs(const string& filename, bool do_preprocess) {
+  const bool use_cache = not graph_cache_filename.empty();
+  const graph_mode mode = adjacency_mode == "dense"    ? graph_mode::dense
+                          : adjacency_mode == "sparse" ? graph_mode::sparse
+                                                       : graph_mode::automatic;
+  // When pre-processing, a new cache is written once, with the core block.
+  const bool save_core = use_cache and do_preprocess;
+  if (load_graph(filename, graph_cache_filename, gcache, mode, not save_core) and
+      verb >= 1)
+    pr("--graph cache: {}\n", graph_cache_filename);
+  if (irace_its and gcache.k_its) k = gcache.k_its;
+  if (irace and gcache.k_irace) k = gcache.k_irace;
+  n_ori = gcache.raw.n, m_ori = gcache.raw.m;
+  sparse_graph = is_sparse(mode, n_ori, m_ori);
+  if (verb >= 1) pr("--n: {}, m: {}{}\n", n_ori, m_ori, sparse_graph ? " (sparse)" : "");
+  const bool cached_core = do_preprocess and gcache.has_core(k);
+  install(cached_core ? gcache.core : gcache.raw, gcache.is_mapped() or save_core);
+  if (not cached_core and do_preprocess) preprocess();
   ind_n.resize(n);
   iota(begin(ind_n), end(ind_n), 0);
-  ind_deg = ind_n;
-  sort_by_degree(ind_deg);
-  ind_deg_cum = vi(n, 0);
-  ind_deg_cum[0] = AL[ind_deg[0]].size();
-  for (int i = 1; i < n; ++i)
-    ind_deg_cum[i] = ind_deg_cum[i - 1] + AL[ind_deg[i]].size();
+  if (not ind_deg.empty()) {
+    shuffle(begin(ind_n), end(ind_n), rng);
+  } else {
+    ind_deg = ind_n;
+    sort_by_degree(ind_deg);
+    ind_deg_cum = vi(n, 0);
+    ind_deg_cum[0] = AL.degree(ind_deg[0]);
+    for (int i = 1; i < n; ++i)
+      ind_deg_cum[i] = ind_deg_cum[i - 1] + AL.degree(ind_deg[i]);
+    if (save_core) {
+      gcache.core = {n, m, k, move(AM), move(AL), move(vmap), ind_deg, ind_deg_cum};
+      gcache.save(graph_cache_filename, filename);
+      install(gcache.core, false);
+      if (not gcache.is_mapped()) gcache.raw = graph_block();
+    }
+  }
+  if (relabel_order == "degeneracy") {
+    vi order;
+    core_numbers(AL, &order);
+    relabel(order);
+  } else if (relabel_order == "rcm") {
+    relabel(rcm_order(AL));
+  }
 }
 void preprocess() {
+  const int n_bef = n, m_bef = m;
+  auto core = core_numbers(AL);
+  vi vs;
+  for (int i = 0; i < n; ++i)
+    if (core[i] >= k - 1) vs.push_back(i);
+  vector<vi> bl;
   while (true) {
-    auto n_bef = n, m_bef = m;
-    auto AM_bef = move(AM);
-    auto AL_bef = move(AL);
-    auto vmap_bef = move(vmap);
-    assert(vmap.empty());
-    vi vs;
-    for (int i = 0; i < n_bef; ++i)
-      if ((int)AL_bef[i].size() >= k - 1) {
-        vs.push_back(i);
-        vmap.push_back(vmap_bef[i]);
-      }
-    n = vs.size();
-    m = 0;
-    AL.resize(n);
-    AM.assign(n, vi(n, 0));
+    vb keep(n, false);
+    for (int i = 0, nb = blocks(AL, vs, bl); i < nb; ++i)
+      if ((int)bl[i].size() >= k)
+        for (int v : induced_core(AL, bl[i], k - 1))
+          keep[v] = true;
+    int sz = vs.size();
+    vs.erase(remove_if(begin(vs), end(vs), [&](int v) { return not keep[v]; }), end(vs));
+    if ((int)vs.size() == sz) break;
+    vs = induced_core(AL, vs, k - 1);
+  }
+  if ((int)vs.size() < n) {
+    AL = induced_subgraph(AL, vs);
+    for (int i = 0; i < (int)vs.size(); ++i)
+      vmap[i] = vmap[vs[i]];
+    n = vs.size(), m = 0;
+    vmap.resize(n);
+    AM = bit_matrix();
+    if (not sparse_graph) AM.assign(n);
     for (int i = 0; i < n; ++i)
-      for (int j = i + 1; j < n; ++j) {
-        if (AM_bef[vs[i]][vs[j]]) {
-          AM[i][j] = AM[j][i] = 1;
-          AL[i].push_back(j);
-          AL[j].push_back(i);
+      for (int j : AL[i])
+        if (j > i) {
           ++m;
+          if (not sparse_graph) AM.add_edge(i, j);
         }
-      }
-    if (verb >= 1)
-      pr("Preprocess, n,m before: {},{}; n,m after: {},{}\n", n_bef, m_bef, n, m);
-    if (n_bef == n and m_bef == m) break;
   }
+  if (verb >= 1)
+    pr("Preprocess, n,m before: {},{}; n,m after: {},{}\n", n_bef, m_bef, n, m);
   if (n == 0) {
     stats::infeas = true;
     if (verb >= 1) {
@@ -276,3 +342,22 @@ void preprocess() {
     exit(EXIT_SUCCESS);
   }
 }
+void relabel(const vi& order) {
+  vi pos(n);
+  for (int i = 0; i < n; ++i)
+    pos[order[i]] = i;
+  AL = permuted(AL, order);
+  auto vmap_bef = move(vmap);
+  vmap.resize(n);
+  for (int i = 0; i < n; ++i)
+    vmap[i] = vmap_bef[order[i]];
+  for (int& v : ind_deg)
+    v = pos[v];
+  AM = bit_matrix();
+  if (not sparse_graph) {
+    AM.assign(n);
+    for (int i = 0; i < n; ++i)
+      for (int j : AL[i])
+        AM.set(i, j);
+  }
+}
@@ -26,3 +26,4 @@
 void cmd_line(int argc, char** argv);
 void read_dimacs(const string& filename, bool do_preprocess);
 void preprocess();
+void relabel(const vi& order);
@@ -50,7 +50,7 @@ double energy(const vi& ss) {
   vd adj_mat(sz * sz);
   for (int i = 0; i < sz; ++i)
     for (int j = 0; j < sz; ++j)
-      adj_mat[i * sz + j] = AM[ss[i]][ss[j]];
+      adj_mat[i * sz + j] = adjacent(ss[i], ss[j]);
   vd eig = get_eigen(adj_mat, sz);
   double en = accumulate(begin(eig), end(eig), 0.0) / double(eig.size());
   return en;
@@ -61,7 +61,7 @@ double algebraic_connectivity(const vi& ss) {
   vd lap_mat(sz * sz);
   for (int i = 0; i < sz; ++i)
     for (int j = 0; j < sz; ++j)
-      lap_mat[i * sz + j] = (i == j) ? size(AL[ss[i]]) : -AM[ss[i]][ss[j]];
+      lap_mat[i * sz + j] = (i == j) ? size(AL[ss[i]]) : -adjacent(ss[i], ss[j]);
   vd eig = get_eigen(lap_mat, sz);
   sort(begin(eig), end(eig));
   if (eig.size() <= 1)
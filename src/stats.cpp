@@ -26,6 +26,13 @@
 #include "main.h"
 #include "sm.h"
 #include "subgraph.h"
+void* operator new(size_t sz) {
+  ++stats::thread_allocs;
+  if (void* p = malloc(sz ? sz : 1)) return p;
+  throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
 namespace stats {
 subgraph best_sg;
 void print_summary() {
@@ -57,6 +64,8 @@ void print_summary() {
   pr("time_confirm_chroma={} ", confirm_chroma_time);
   pr("time_confirm_crit={} ", confirm_crit_time);
   pr("time_color={} ", color_time - confirm_crit_time - confirm_chroma_time);
+  pr("time_ls={} ", ls_time);
+  pr("ls_moves_per_sec={} ", divOrNA(tot_ls_moves, ls_time));
   pr("iter={} ", global_iter);
   pr("ttb={} ", ttb);
   pr("itb={} ", itb);
@@ -69,11 +78,34 @@ void print_summary() {
   pr("num_pp={} ", num_pp);
   pr("avg_pp_reduced={} ", divOrNA(pp_reduced, num_pp));
   pr("avg_pp_skipped={} ", divOrNA(trivial_crits_found, num_pp));
+  pr("pp_retries={} ", pp_retries);
   pr("calls_to_coloring={} ", cals_to_coloring);
   pr("num_gen_subsets={} ", num_gen_subsets);
   pr("infeas={} ", (int)infeas);
   pr("clique_start={} ", cliq_1st_size);
   pr("color_not_ok={} ", color_not_ok);
+  pr("search_blocks={} ", search_blocks);
+  pr("block_splits={} ", block_splits);
+  pr("drop_resumes={} ", drop_resumes);
+  flush_allocs();
+  pr("allocs={} ", allocs.load());
+  pr("allocs_per_gen={} ", divOrNA(gen_allocs, num_gen_subsets));
+  pr("allocs_per_check={} ", divOrNA(check_allocs, num_gen_subsets));
+  pr("verdict_hits={} ", verdict_hits);
+  pr("verdict_hit_rate={} ", divOrNA(verdict_hits, verdict_lookups));
+  pr("filter_core={} ", filter_core);
+  pr("filter_dsatur={} ", filter_dsatur);
+  pr("filter_ky={} ", filter_ky);
+  pr("filter_clique={} ", filter_clique);
+  pr("tier_culled={} ", tier_culled);
+  pr("tier_full={} ", tier_full);
+  pr("size_skips={} ", size_skips);
+  pr("size_cuts={} ", size_cuts);
+  pr("size_probes_moot={} ", size_probes_moot);
+  pr("races={} ", races);
+  pr("race_exact_rate={} ", divOrNA(race_exact_wins, races));
+  pr("race_heu_rate={} ", divOrNA(race_heu_wins, races));
+  pr("relabel={} ", relabel_order);
   pr("seed={} ", random_seed);
   pr("\n");
 }
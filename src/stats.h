@@ -26,30 +26,30 @@
 namespace stats {
 inline double pp_time;
 inline int num_pp = 0;
-inline int heu_mistk = 0;
+inline atomic<int> heu_mistk{0};
 inline int pp_reduced = 0;
-inline int suc_ext_cals = 0;
-inline int unsuc_ext_cals = 0;
-inline int suc_heu_cals = 0;
-inline int unsuc_heu_cals = 0;
-inline int cals_to_coloring = 0;
+inline atomic<int> suc_ext_cals{0};
+inline atomic<int> unsuc_ext_cals{0};
+inline atomic<int> suc_heu_cals{0};
+inline atomic<int> unsuc_heu_cals{0};
+inline atomic<int> cals_to_coloring{0};
 inline int n_subsets =
     0;
 inline int skip_cons_ls_cache =
     0;
-inline int num_ls = 0;
-inline int tot_ls_moves = 0;
-inline int64_t tot_cons_edges =
-    0;
-inline int num_size_att = 0;
-inline int suc_size_att =
-    0;
+inline atomic<int> num_ls{0};
+inline atomic<int64_t> tot_ls_moves{0};
+inline atomic<double> ls_time{0.0};
+inline atomic<int64_t> tot_cons_edges{0};
+inline atomic<int> num_size_att{0};
+inline atomic<int> suc_size_att{0};
 inline int cliq_1st_size = 0;
 inline int gen_rep = 0;
 inline double tot_size_gen =
     0;
-inline int num_gen_subsets = 0;
+inline atomic<int> num_gen_subsets{0};
 inline double tot_size_fin = 0;
+inline int pp_retries = 0;
 inline int trivial_crits_found =
     0;
 inline int global_iter = 0;
@@ -65,12 +65,43 @@ inline bool confirmed_crit =
 inline double confirm_crit_time = 0.0;
 inline double confirm_chroma_time = 0.0;
 inline double time = 0.0;
-inline double color_time = 0.0;
+inline atomic<double> color_time{0.0};
 inline bool infeas = false;
 inline int max_iter_diff = 0;
 inline int gen_best_1st_phase = 0;
 inline int fin_best_1st_phase = 0;
-inline int color_not_ok = 0;
+inline atomic<int> color_not_ok{0};
+inline int search_blocks = 0;
+inline atomic<int> block_splits{0};
+inline atomic<int> drop_resumes{0};
+inline thread_local int64_t thread_allocs = 0, thread_allocs_flushed = 0;
+inline atomic<int64_t> allocs{0};
+inline atomic<int64_t> gen_allocs{0};
+inline atomic<int64_t> check_allocs{0};
+inline atomic<int> verdict_lookups{0};
+inline atomic<int> verdict_hits{0};
+inline atomic<int> filter_core{0};
+inline atomic<int> filter_dsatur{0};
+inline atomic<int> filter_ky{0};
+inline atomic<int> filter_clique{0};
+inline atomic<int> tier_culled{0};
+inline atomic<int> tier_full{0};
+inline atomic<int> size_skips{0};
+inline atomic<int> size_cuts{0};
+inline atomic<int> size_probes_moot{0};
+inline atomic<int> races{0};
+inline atomic<int> race_exact_wins{0};
+inline atomic<int> race_heu_wins{0};
+inline void add(atomic<double>& a, double x) {
+  for (double o = a; not a.compare_exchange_weak(o, o + x);) {
+  }
+}
+// Adds the allocations of the calling thread since its last flush to the
+// total. Each thread counts on its own so that allocating stays uncontended.
+inline void flush_allocs() {
+  allocs += thread_allocs - thread_allocs_flushed;
+  thread_allocs_flushed = thread_allocs;
+}
 void print_stats();
 void print_summary();
 inline bool do_print = true;
@@ -24,32 +24,42 @@
 #include "subgraph.h"
 #include "cons.h"
 #include "ls.h"
-subgraph& subgraph::update_all() {
+namespace {
+struct scratch {
+  bit_set in_ss;
+};
+thread_local bit_set& in_ss = per_thread<scratch>().in_ss;
+} // namespace
+template <typename I> basic_subgraph<I>& basic_subgraph<I>::update_all() {
   n = ss.size();
   deg.assign(::n, 0);
-  for (int i = 0; i < ::n; ++i)
-    for (int j = 0; j < n; ++j)
-      if (inrange(ss[j], 0, ::n - 1)) deg[i] += AM[i][ss[j]];
-  m = 0;
+  if (sparse_graph) {
+    for (int v : ss)
+      if (inrange(v, 0, ::n - 1))
+        for (int j : AL[v])
+          ++deg[j];
+  } else {
+    in_ss.assign(::n);
+    for (int v : ss)
+      if (inrange(v, 0, ::n - 1)) in_ss.set(v);
+    for (int i = 0; i < ::n; ++i)
+      deg[i] = AM.count(i, in_ss);
+  }
+  m = 0, hash = 0;
   for (int v : ss)
-    if (inrange(v, 0, ::n - 1)) m += deg[v];
+    if (inrange(v, 0, ::n - 1)) m += deg[v], hash ^= zobrist_key(v);
   m /= 2;
+  reindex();
   return *this;
 }
-void subgraph::swap(int i, int v) {
-  int old = ss[i];
-  ss[i] = v;
-  assert(inrange(old, 0, ::n - 1) and inrange(v, 0, ::n - 1));
-  for (int j = 0; j < ::n; ++j)
-    deg[j] = deg[j] - AM[old][j] + AM[v][j];
-  m = 0;
-  for (int v : ss)
-    if (inrange(v, 0, ::n - 1)) {
-      m += deg[v];
-    }
-  m /= 2;
+template <typename I> void basic_subgraph<I>::reindex() {
+  pos.assign(::n, -1);
+  for (int i = 0; i < (int)ss.size(); ++i)
+    if (inrange(int(ss[i]), 0, ::n - 1)) pos[ss[i]] = i;
 }
-void subgraph::set_ss(vi ss2) {
+template <typename I> void basic_subgraph<I>::set_ss(vec ss2) {
   ::swap(ss, ss2);
   update_all();
 }
+template struct basic_subgraph<int>;
+template struct basic_subgraph<uint16_t>;
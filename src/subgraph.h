@@ -23,22 +23,44 @@
 */
 #pragma once       
 #include "main.h"
-struct subgraph {
-  subgraph() = default;
-  subgraph(vi ss) { set_ss(move(ss)); }
-  subgraph(int sz) { set_size(sz); }
+template <typename I> struct basic_subgraph {
+  using vec = vector<I>;
+  basic_subgraph() = default;
+  basic_subgraph(vi ss) { set_ss(vec(begin(ss), end(ss))); }
+  basic_subgraph(int sz) { set_size(sz); }
   void set_size(int sz) {
     ss.assign(sz, -1);
     n = sz;
   }
-  void set_ss(vi ss2);
-  subgraph& update_all();
+  void set_ss(vec ss2);
+  basic_subgraph& update_all();
+  void reindex();
+  bool contains(int v) const { return pos[v] != I(-1); }
   int m_cost_swap(int i, int v) {
-    return m - deg[ss[i]] + deg[v] - AM[ss[i]][v];
+    return m - deg[ss[i]] + deg[v] - adjacent(ss[i], v);
   }
-  void swap(int i, int v);
-  vi deg;
-  vi ss;
+  void swap(int i, int v) { swap(i, v, [](int, int) {}); }
+  template <typename F> void swap(int i, int v, F moved);
+  vec deg;
+  vec ss;
+  vec pos;
   int n = 0;
   int m = 0;
+  uint64_t hash = 0;
 };
+template <typename I>
+template <typename F>
+void basic_subgraph<I>::swap(int i, int v, F moved) {
+  int old = ss[i];
+  assert(inrange(old, 0, ::n - 1) and inrange(v, 0, ::n - 1) and not contains(v));
+  m = m_cost_swap(i, v);
+  hash ^= zobrist_key(old) ^ zobrist_key(v);
+  ss[i] = v;
+  pos[old] = -1, pos[v] = i;
+  for_each_adjacent(old, [&](int j) { moved(j, deg[j]--); });
+  for_each_adjacent(v, [&](int j) { moved(j, deg[j]++); });
+}
+using subgraph = basic_subgraph<int>;
+using narrow_subgraph = basic_subgraph<uint16_t>;
+// Whether vertex ids, degrees and the -1 marker all fit in a narrow_subgraph.
+inline bool narrow_ids() { return ::n <= numeric_limits<uint16_t>::max(); }
@@ -115,11 +115,27 @@ class timer {
   using timepoint = clock::time_point;
   timepoint tpstart;
   double tmlim;
+  array<const atomic<bool>*, 8> stops{};
 public:
   timer(double time_lim_secs = nld::max()) { reset(time_lim_secs); }
-  timer(double time_lim_secs, const timer& parent) {
+  timer(double time_lim_secs, const timer& parent) : stops(parent.stops) {
     reset(min(time_lim_secs, parent.secs_left()));
   }
+  // Makes this timer, and timers derived from it, time out once flag is set,
+  // in addition to the flags it already had.
+  void stop_on(const atomic<bool>& flag) {
+    auto it = find(begin(stops), end(stops), nullptr);
+    if (it == end(stops)) {
+      print(stderr, "Timer already has {} stop flags.\n", stops.size());
+      abort();
+    }
+    *it = &flag;
+  }
+  bool stopped() const {
+    for (auto s : stops)
+      if (s and s->load(memory_order_relaxed)) return true;
+    return false;
+  }
   void reset(double time_lim_secs = nld::max()) {
     tmlim = time_lim_secs, tpstart = clock::now();
   }
@@ -127,8 +143,8 @@ public:
     return chrono::duration_cast<chrono::duration<double>>(clock::now() - tpstart)
         .count();
   }
-  double secs_left() const { return tmlim - elapsed_secs(); }
-  bool timed_out() const { return elapsed_secs() >= tmlim; }
+  double secs_left() const { return stopped() ? 0.0 : tmlim - elapsed_secs(); }
+  bool timed_out() const { return stopped() or elapsed_secs() >= tmlim; }
 };
 struct timeout_exception {
   timer t;
@@ -170,16 +186,20 @@ template <typename T> struct hash<std::vector<T>> {
 #undef USE_TIMED_BLOCKS
 #endif
 #ifdef USE_TIMED_BLOCKS
-inline unordered_map<string, double> timedBlocks;
+inline unordered_map<const char*, double> timedBlocks;
+inline mutex timedBlocksMutex;
 #endif
 struct TimedBlock {
 #ifdef USE_TIMED_BLOCKS
-  TimedBlock(const string& name) : name(name) {}
-  ~TimedBlock() { timedBlocks[name] += tm.elapsed_secs(); }
-  string name;
+  TimedBlock(const char* name) : name(name) {}
+  ~TimedBlock() {
+    lock_guard<mutex> lock(timedBlocksMutex);
+    timedBlocks[name] += tm.elapsed_secs();
+  }
+  const char* name;
   timer tm;
 #else
-  TimedBlock(const string&) {}
+  TimedBlock(const char*) {}
 #endif
 };
 #define COMBINE1(X,Y) X ##Y
@@ -187,8 +207,11 @@ struct TimedBlock {
 #define TIME_BLOCK(s) TimedBlock COMBINE(tbDummy, __LINE__)(s)
 inline void print_timed_blocks() {
 #ifdef USE_TIMED_BLOCKS
-  vector<pair<double, string>> tbS;
+  map<string, double> byName;
   for (const auto& p : timedBlocks)
+    byName[p.first] += p.second;
+  vector<pair<double, string>> tbS;
+  for (const auto& p : byName)
     tbS.emplace_back(-p.second, p.first);
   sort(begin(tbS), end(tbS));
   if (!timedBlocks.empty()) {
@@ -217,6 +240,25 @@ struct tabu_list {
   vi tabu;
   int iter, ten, sz;
 };
+inline uint64_t zobrist_key(int v) {
+  uint64_t z = uint64_t(v) + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+inline uint64_t zobrist_hash(const vi& ss) {
+  uint64_t h = 0;
+  for (int v : ss)
+    h ^= zobrist_key(v);
+  return h;
+}
+// The instance of T of the calling thread. It is never destroyed, so it is
+// still usable from the exit handler, which runs after thread_local
+// destructors.
+template <typename T> T& per_thread() {
+  static thread_local T* p = new T;
+  return *p;
+}
 inline string valOrNA(bool yes, double val) { return yes ? format("{}", val) : "NA"; }
 inline string divOrNA(double num, double den) { return valOrNA(den, num / den); }
 struct options_counter {